@@ -199,6 +199,26 @@ TARGET_LINK_LIBRARIES("bibletime"
 )
 
 
+######################################################
+# The bibletime_bench backend benchmarks. These only link the backend and run
+# headless on generated modules, see src/bench/main.cpp. BtTextFilter only
+# depends on the backend, hence it is benchmarked as well:
+#
+IF(BUILD_BENCHMARKS)
+    FILE(GLOB_RECURSE bibletime_bench_SOURCES CONFIGURE_DEPENDS
+        "${CMAKE_CURRENT_SOURCE_DIR}/src/bench/*.cpp"
+        "${CMAKE_CURRENT_SOURCE_DIR}/src/bench/*.h"
+    )
+    LIST(APPEND bibletime_bench_SOURCES
+        "${CMAKE_CURRENT_SOURCE_DIR}/src/frontend/display/modelview/bttextfilter.cpp"
+        "${CMAKE_CURRENT_SOURCE_DIR}/src/frontend/display/modelview/bttextfilter.h"
+    )
+    ADD_EXECUTABLE("bibletime_bench" ${bibletime_bench_SOURCES})
+    PREPARE_CXX_TARGET(bibletime_bench)
+    TARGET_LINK_LIBRARIES("bibletime_bench" PRIVATE bibletime_backend)
+ENDIF()
+
+
 ######################################################
 # Define rules to generate and install translation files:
 #
@@ -209,6 +229,10 @@ INCLUDE("${CMAKE_CURRENT_SOURCE_DIR}/cmake/BTUITranslation.cmake")
 # Installation:
 #
 INSTALL(TARGETS "bibletime" DESTINATION "${BT_BINDIR}")
+IF(BUILD_BENCHMARKS)
+    # Needs the installed data files like the application itself:
+    INSTALL(TARGETS "bibletime_bench" DESTINATION "${BT_BINDIR}")
+ENDIF()
 FILE(GLOB INSTALL_ICONS_LIST CONFIGURE_DEPENDS
         "${CMAKE_CURRENT_SOURCE_DIR}/pics/icons/*.svg")
 INSTALL(FILES ${INSTALL_ICONS_LIST}
@@ -24,25 +24,20 @@
 
 #include <algorithm>
 #include <memory>
+#include <QByteArray>
 #include <QDir>
-#include <QDomElement>
-#include <QDomNode>
 #include <QFile>
 #include <QIODevice>
 #include <QList>
+#include <QSaveFile>
 #include <QString>
-#if (QT_VERSION < QT_VERSION_CHECK(6, 0, 0))
-    #include <QTextCodec>
-#endif
-#include <QTextStream>
-#include <QTime>
-#include <QTimer>
+#include <QStringList>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
 #include <utility>
 #include "../util/btassert.h"
-#include "../util/btconnect.h"
 #include "../util/cresmgr.h"
 #include "../util/directory.h"
-#include "../util/tool.h"
 #include "btglobal.h"
 #include "config/btconfig.h"
 #include "drivers/cswordmoduleinfo.h"
@@ -51,6 +46,7 @@
 
 
 #define CURRENT_SYNTAX_VERSION 1
+#define MAX_JOURNAL_ENTRIES 1000
 
 
 namespace {
@@ -228,10 +224,7 @@ public: // methods:
     BtBookmarksModelPrivate(BtBookmarksModel * parent)
         : m_rootItem(new BookmarkFolder(QStringLiteral("Root")))
         , q_ptr(parent)
-    {
-        m_saveTimer.setInterval(30 * 1000);
-        m_saveTimer.setSingleShot(true);
-    }
+    {}
     ~BtBookmarksModelPrivate() { delete m_rootItem; }
 
     static QString defaultBookmarksFile() {
@@ -282,183 +275,434 @@ public: // methods:
         }
     }
 
-    void needSave(){
-        if(m_defaultModel == q_ptr){
-            if(!m_saveTimer.isActive())
-                m_saveTimer.start();
+    static QString journalFile() {
+        return util::directory::getUserBaseDir().absolutePath()
+                + QStringLiteral("/bookmarks.journal");
+    }
+
+    /** \returns whether the item is written to bookmark files. */
+    static bool isSaved(BookmarkItemBase const * const item) {
+        return dynamic_cast<BookmarkFolder const *>(item)
+               || dynamic_cast<BookmarkItem const *>(item);
+    }
+
+    /** \returns the number of saved children of parent in front of row. */
+    static int savedRow(BookmarkItemBase const * const parent, int const row) {
+        int r = 0;
+        for (int i = 0; i < row; ++i)
+            if (isSaved(parent->child(i)))
+                ++r;
+        return r;
+    }
+
+    /** \returns the saved rows from the root item to the given item. */
+    QString itemPath(BookmarkItemBase const * item) const {
+        QStringList rows;
+        for (; item != m_rootItem; item = item->parent())
+            rows.prepend(QString::number(savedRow(item->parent(),
+                                                  item->index())));
+        return rows.join('/');
+    }
+
+    /**
+      \returns the item at the given path under root or nullptr if there is no
+               such item.
+      \pre All items under root are saved items, like in a freshly loaded tree.
+    */
+    static BookmarkItemBase * itemAtPath(BookmarkItemBase * item,
+                                         QString const & path)
+    {
+        for (auto const & row : path.split('/', Qt::SkipEmptyParts)) {
+            bool ok;
+            int const r = row.toInt(&ok);
+            if (!ok || r < 0 || r >= item->childCount())
+                return nullptr;
+            item = item->child(r);
         }
+        return item;
     }
 
     /** Loads a list of items (with subitem trees) from a named file
     * or from the default bookmarks file. */
     QList<BookmarkItemBase *> loadTree(QString fileName = QString()) {
-        QList<BookmarkItemBase*> itemList;
+        if (fileName.isEmpty())
+            fileName = defaultBookmarksFile();
 
-        QDomDocument doc;
-        QString bookmarksFile = loadXmlFromFile(fileName);
-        if (bookmarksFile.isNull())
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly))
             return QList<BookmarkItemBase*>();
 
-        doc.setContent(bookmarksFile);
-        QDomElement document = doc.documentElement();
-        if (document.tagName() != QStringLiteral("SwordBookmarks")) {
+        QXmlStreamReader reader(&file);
+        if (!reader.readNextStartElement()
+            || reader.name() != QStringLiteral("SwordBookmarks"))
+        {
             qWarning("Not a BibleTime Bookmark XML file");
             return QList<BookmarkItemBase*>();
         }
+        if (fileName == defaultBookmarksFile())
+            m_journalGeneration =
+                    reader.attributes().value(
+                        QStringLiteral("journalGeneration")).toInt();
 
-        QDomElement child = document.firstChild().toElement();
-
-        while ( !child.isNull() && child.parentNode() == document) {
-            BookmarkItemBase* i = handleXmlElement(child, nullptr);
-            itemList.append(i);
-            if (!child.nextSibling().isNull()) {
-                child = child.nextSibling().toElement();
-            }
-            else {
-                child = QDomElement(); //null
-            }
-
-        }
+        QList<BookmarkItemBase*> itemList;
+        while (reader.readNextStartElement())
+            if (BookmarkItemBase * const i = readItem(reader, nullptr))
+                itemList.append(i);
+        if (reader.hasError())
+            qWarning("Error reading bookmarks from %s: %s",
+                     qPrintable(fileName),
+                     qPrintable(reader.errorString()));
 
         return itemList;
     }
 
-    /** Create a new item from a document element. */
-    BookmarkItemBase * handleXmlElement(QDomElement & element, BookmarkItemBase * parent) {
-        if (element.tagName() == QStringLiteral("Folder")) {
-            BookmarkFolder* newFolder = new BookmarkFolder(QString(), parent);
-            if (element.hasAttribute(QStringLiteral("caption"))) {
-                newFolder->setText(element.attribute(
-                                       QStringLiteral("caption")));
-            }
-            QDomNodeList childList = element.childNodes();
-            for (int i = 0; i < childList.length(); i++) {
-                QDomElement newElement = childList.at(i).toElement();
-                handleXmlElement(newElement, newFolder); // passing parent in constructor will add items to tree
-            }
+    /** Creates a new item with its subitems from the current start element. */
+    BookmarkItemBase * readItem(QXmlStreamReader & reader,
+                                BookmarkItemBase * parent)
+    {
+        auto const attributes = reader.attributes();
+        if (reader.name() == QStringLiteral("Folder")) {
+            BookmarkFolder* newFolder =
+                    new BookmarkFolder(
+                        attributes.value(QStringLiteral("caption")).toString(),
+                        parent);
+            while (reader.readNextStartElement())
+                readItem(reader, newFolder); // passing parent in constructor will add items to tree
             return newFolder;
         }
-        if (element.tagName() == QStringLiteral("Bookmark")) {
+        if (reader.name() == QStringLiteral("Bookmark")) {
             BookmarkItem* newBookmarkItem = new BookmarkItem(parent);
-            if (element.hasAttribute(QStringLiteral("modulename"))) {
+            if (attributes.hasAttribute(QStringLiteral("modulename"))) {
                 //we use the name in all cases, even if the module isn't installed anymore
                 newBookmarkItem->setModule(
-                            element.attribute(QStringLiteral("modulename")));
+                            attributes.value(
+                                QStringLiteral("modulename")).toString());
             }
-            if (element.hasAttribute(QStringLiteral("key"))) {
+            if (attributes.hasAttribute(QStringLiteral("key"))) {
                 newBookmarkItem->setKey(
-                            element.attribute(QStringLiteral("key")));
+                            attributes.value(QStringLiteral("key")).toString());
             }
-            if (element.hasAttribute(QStringLiteral("description"))) {
+            if (attributes.hasAttribute(QStringLiteral("description"))) {
                 newBookmarkItem->setDescription(
-                            element.attribute(QStringLiteral("description")));
+                            attributes.value(
+                                QStringLiteral("description")).toString());
             }
-            if (element.hasAttribute(QStringLiteral("title"))) {
+            if (attributes.hasAttribute(QStringLiteral("title"))) {
                 newBookmarkItem->setText(
-                            element.attribute(QStringLiteral("title")));
+                            attributes.value(QStringLiteral("title")).toString());
             }
+            reader.skipCurrentElement();
             return newBookmarkItem;
         }
+        reader.skipCurrentElement();
         return nullptr;
     }
 
-    /** Loads a bookmark XML document from a named file or from the default bookmarks file. */
-    QString loadXmlFromFile(QString fileName = QString()) {
+    /** Writes one item with its subitems. */
+    static void writeItem(QXmlStreamWriter & writer,
+                          BookmarkItemBase const * const item)
+    {
+        if (auto const * const folderItem =
+                dynamic_cast<BookmarkFolder const *>(item))
+        {
+            writer.writeStartElement(QStringLiteral("Folder"));
+            writer.writeAttribute(QStringLiteral("caption"),
+                                  folderItem->text());
+            for (int i = 0; i < folderItem->childCount(); i++)
+                writeItem(writer, folderItem->child(i));
+            writer.writeEndElement();
+        } else if (auto const * const bookmarkItem =
+                       dynamic_cast<BookmarkItem const *>(item))
+        {
+            writer.writeStartElement(QStringLiteral("Bookmark"));
+            writer.writeAttribute(QStringLiteral("key"),
+                                  bookmarkItem->englishKey());
+            writer.writeAttribute(QStringLiteral("description"),
+                                  bookmarkItem->description());
+            writer.writeAttribute(QStringLiteral("modulename"),
+                                  bookmarkItem->moduleName());
+            writer.writeAttribute(QStringLiteral("moduledescription"),
+                                  bookmarkItem->module()
+                                  ? bookmarkItem->module()->config(
+                                        CSwordModuleInfo::Description)
+                                  : QString());
+            if (!bookmarkItem->text().isEmpty())
+                writer.writeAttribute(QStringLiteral("title"),
+                                      bookmarkItem->text());
+            writer.writeEndElement();
+        }
+    }
 
-        if (fileName.isEmpty())
-            fileName = defaultBookmarksFile();
+    /** Takes one item and saves the tree which is under it to a named file.
+        The file is replaced atomically, i.e. it is left untouched on errors. */
+    static bool saveTree(QString const & fileName,
+                         BookmarkItemBase const * const rootItem,
+                         int const journalGeneration = 0)
+    {
+        BT_ASSERT(rootItem);
 
-        QFile file(fileName);
-        if (!file.exists())
-            return QString();
+        QSaveFile file(fileName);
+        if (!file.open(QIODevice::WriteOnly)) {
+            qWarning("Failed to open %s for writing bookmarks",
+                     qPrintable(fileName));
+            return false;
+        }
 
-        QString xml;
-        if (file.open(QIODevice::ReadOnly)) {
-            QTextStream t;
-            t.setAutoDetectUnicode(false);
+        QXmlStreamWriter writer(&file);
+        writer.setAutoFormatting(true);
+        writer.writeStartDocument();
+        writer.writeStartElement(QStringLiteral("SwordBookmarks"));
+        writer.writeAttribute(QStringLiteral("syntaxVersion"),
+                              QString::number(CURRENT_SYNTAX_VERSION));
+        if (journalGeneration > 0)
+            writer.writeAttribute(QStringLiteral("journalGeneration"),
+                                  QString::number(journalGeneration));
 
-#if (QT_VERSION < QT_VERSION_CHECK(6, 0, 0))
-            t.setCodec(QTextCodec::codecForName(QByteArrayLiteral("UTF-8")));
-#else
-            t.setEncoding(QStringConverter::Utf8);
-#endif
-            t.setDevice(&file);
-            xml = t.readAll();
-            file.close();
+        //append the XML nodes of all child items
+        for (int i = 0; i < rootItem->childCount(); i++)
+            writeItem(writer, rootItem->child(i));
+        writer.writeEndDocument();
+
+        if (writer.hasError() || !file.commit()) {
+            qWarning("Failed to write bookmarks to %s", qPrintable(fileName));
+            return false;
         }
-        return xml;
+        return true;
     }
 
-    /** Takes one item and saves the tree which is under it to a named file
-    * or to the default bookmarks file, asking the user about overwriting if necessary. */
-    QString serializeTreeFromRootItem(BookmarkItemBase * rootItem) {
-        BT_ASSERT(rootItem);
+    /*
+      Changes to the default bookmarks are not written by rewriting the whole
+      bookmarks file, but appended to a journal beside it. Every line of the
+      journal is a self-contained XML element. The first line holds the
+      generation of the bookmarks file the journal applies to, the others
+      describe one change each, addressing items by their path of rows from the
+      root item. On load the journal is replayed on top of the bookmarks file.
+      Once the journal grows too long it is compacted, i.e. the bookmarks file
+      is rewritten with the next generation and the journal is restarted. A
+      journal left behind by a compaction interrupted after writing the
+      bookmarks file is thereby recognized as stale by its generation.
+    */
+
+    /** Rewrites the default bookmarks file and restarts the journal. */
+    bool compact() {
+        int const generation = m_journalGeneration + 1;
+        if (!saveTree(defaultBookmarksFile(), m_rootItem, generation))
+            return false;
+        m_journalGeneration = generation;
+        return resetJournal();
+    }
 
-        QDomDocument doc(QStringLiteral("DOC"));
-        doc.appendChild(
-                    doc.createProcessingInstruction(
-                        QStringLiteral("xml"),
-                        QStringLiteral("version=\"1.0\" encoding=\"UTF-8\"")));
+    /** Truncates the journal and writes its header. */
+    bool resetJournal() {
+        m_journal.close();
+        m_journal.setFileName(journalFile());
+        m_journalEntries = 0;
+        if (!m_journal.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qWarning("Failed to open the bookmarks journal for writing");
+            return false;
+        }
+        return writeJournalLine(
+                    [this](QXmlStreamWriter & writer) {
+                        writer.writeStartElement(QStringLiteral("Journal"));
+                        writer.writeAttribute(
+                                    QStringLiteral("generation"),
+                                    QString::number(m_journalGeneration));
+                        writer.writeEndElement();
+                    });
+    }
 
-        auto content =
-                doc.createElement(QStringLiteral("SwordBookmarks"));
-        content.setAttribute(QStringLiteral("syntaxVersion"),
-                             CURRENT_SYNTAX_VERSION);
-        doc.appendChild(content);
+    /** Opens the journal for appending further changes. */
+    bool openJournal() {
+        m_journal.setFileName(journalFile());
+        if (!m_journal.exists())
+            return resetJournal();
+        return m_journal.open(QIODevice::WriteOnly | QIODevice::Append);
+    }
 
-        //append the XML nodes of all child items
+    template <typename Write>
+    bool writeJournalLine(Write && write) {
+        QByteArray line;
+        {
+            QXmlStreamWriter writer(&line);
+            write(writer);
+        }
+        line.append('\n');
+        return m_journal.write(line) == line.size() && m_journal.flush();
+    }
 
-        for (int i = 0; i < rootItem->childCount(); i++) {
-            saveItem(rootItem->child(i), content);
+    /** Appends a change to the journal if this is the default model. If the
+        journal can not be written the bookmarks file is rewritten instead. */
+    template <typename Write>
+    void journal(Write && write) {
+        if (m_defaultModel != q_ptr)
+            return;
+        if (!m_journal.isOpen() || !writeJournalLine(write)) {
+            compact();
+        } else if (++m_journalEntries >= MAX_JOURNAL_ENTRIES) {
+            compact();
         }
-        return doc.toString();
     }
 
-    /** Writes one item to a document element. */
-    void saveItem(BookmarkItemBase * item, QDomElement & parentElement) {
-        BookmarkFolder* folderItem = nullptr;
-        BookmarkItem* bookmarkItem = nullptr;
+    /** Journals the insertion of saved items at the given row of parent. */
+    void journalInsert(BookmarkItemBase const * const parent,
+                       int const row,
+                       QList<BookmarkItemBase *> const & items)
+    {
+        journal([&](QXmlStreamWriter & writer) {
+            writer.writeStartElement(QStringLiteral("Insert"));
+            writer.writeAttribute(QStringLiteral("parent"), itemPath(parent));
+            writer.writeAttribute(QStringLiteral("row"),
+                                  QString::number(savedRow(parent, row)));
+            for (auto const * const i : items)
+                writeItem(writer, i);
+            writer.writeEndElement();
+        });
+    }
 
-        if ((folderItem = dynamic_cast<BookmarkFolder*>(item))) {
-            auto elem =
-                    parentElement.ownerDocument().createElement(
-                        QStringLiteral("Folder"));
-            elem.setAttribute(QStringLiteral("caption"), folderItem->text());
+    /** Journals the removal of children of parent, before removing them. */
+    void journalRemove(BookmarkItemBase const * const parent,
+                       int const row,
+                       int const count)
+    {
+        int const savedCount = savedRow(parent, row + count)
+                               - savedRow(parent, row);
+        if (savedCount <= 0)
+            return;
+        journal([&](QXmlStreamWriter & writer) {
+            writer.writeStartElement(QStringLiteral("Remove"));
+            writer.writeAttribute(QStringLiteral("parent"), itemPath(parent));
+            writer.writeAttribute(QStringLiteral("row"),
+                                  QString::number(savedRow(parent, row)));
+            writer.writeAttribute(QStringLiteral("count"),
+                                  QString::number(savedCount));
+            writer.writeEndElement();
+        });
+    }
 
-            parentElement.appendChild(elem);
+    /** Journals a change of the text or description of a saved item. */
+    void journalSet(BookmarkItemBase const * const item,
+                    QString const & attribute,
+                    QString const & value)
+    {
+        if (!isSaved(item))
+            return;
+        journal([&](QXmlStreamWriter & writer) {
+            writer.writeStartElement(QStringLiteral("Set"));
+            writer.writeAttribute(QStringLiteral("item"), itemPath(item));
+            writer.writeAttribute(attribute, value);
+            writer.writeEndElement();
+        });
+    }
+
+    /**
+      \brief Replays the journal of the default bookmarks file.
+      \param[in] root holds the items loaded from the default bookmarks file.
+      \returns whether the journal is missing or was replayed completely.
+    */
+    bool replayJournal(BookmarkFolder & root) {
+        QFile file(journalFile());
+        if (!file.exists())
+            return true;
+        if (!file.open(QIODevice::ReadOnly))
+            return false;
 
-            for (int i = 0; i < folderItem->childCount(); i++) {
-                saveItem(folderItem->child(i), elem);
+        {
+            QXmlStreamReader reader(file.readLine());
+            if (!reader.readNextStartElement()
+                || reader.name() != QStringLiteral("Journal")
+                || reader.attributes().value(
+                       QStringLiteral("generation")).toInt()
+                   != m_journalGeneration)
+            {
+                qWarning("Ignoring stale bookmarks journal");
+                return false;
             }
         }
-        else if ((bookmarkItem = dynamic_cast<BookmarkItem*>(item))) {
-            auto elem =
-                    parentElement.ownerDocument().createElement(
-                        QStringLiteral("Bookmark"));
-
-            elem.setAttribute(QStringLiteral("key"),
-                              bookmarkItem->englishKey());
-            elem.setAttribute(QStringLiteral("description"),
-                              bookmarkItem->description());
-            elem.setAttribute(QStringLiteral("modulename"),
-                              bookmarkItem->moduleName());
-            elem.setAttribute(QStringLiteral("moduledescription"),
-                              bookmarkItem->module()
-                              ? bookmarkItem->module()->config(
-                                    CSwordModuleInfo::Description)
-                              : QString());
-        if (!bookmarkItem->text().isEmpty()) {
-            elem.setAttribute(QStringLiteral("title"), bookmarkItem->text());
+
+        while (!file.atEnd()) {
+            if (!replayEntry(file.readLine(), root)) {
+                qWarning("Ignoring invalid bookmarks journal entries");
+                return false;
+            }
+            ++m_journalEntries;
+        }
+        return true;
+    }
+
+    /** Applies one journal entry to the items under root. */
+    bool replayEntry(QByteArray const & entry, BookmarkFolder & root) {
+        QXmlStreamReader reader(entry);
+        if (!reader.readNextStartElement())
+            return false;
+        auto const attributes = reader.attributes();
+        bool rowOk = false;
+        int const row = attributes.value(QStringLiteral("row")).toInt(&rowOk);
+
+        if (reader.name() == QStringLiteral("Insert")) {
+            auto * const parent =
+                    dynamic_cast<BookmarkFolder *>(
+                        itemAtPath(&root,
+                                   attributes.value(
+                                       QStringLiteral("parent")).toString()));
+            if (!parent || !rowOk || row < 0 || row > parent->childCount())
+                return false;
+            QList<BookmarkItemBase *> items;
+            while (reader.readNextStartElement())
+                if (BookmarkItemBase * const i = readItem(reader, nullptr))
+                    items.append(i);
+            if (reader.hasError()) {
+                qDeleteAll(items);
+                return false;
+            }
+            parent->insertChildren(row, items);
+            return true;
+        }
+
+        if (reader.name() == QStringLiteral("Remove")) {
+            auto * const parent =
+                    itemAtPath(&root,
+                               attributes.value(
+                                   QStringLiteral("parent")).toString());
+            int const count =
+                    attributes.value(QStringLiteral("count")).toInt();
+            if (!parent || !rowOk || row < 0 || count <= 0
+                || row + count > parent->childCount())
+                return false;
+            for (int i = 0; i < count; ++i)
+                parent->removeChild(row);
+            return true;
         }
-            parentElement.appendChild(elem);
+
+        if (reader.name() == QStringLiteral("Set")) {
+            auto const path =
+                    attributes.value(QStringLiteral("item")).toString();
+            auto * const item = itemAtPath(&root, path);
+            if (!item || path.isEmpty())
+                return false;
+            if (attributes.hasAttribute(QStringLiteral("text")))
+                item->setText(
+                            attributes.value(QStringLiteral("text")).toString());
+            if (attributes.hasAttribute(QStringLiteral("description"))) {
+                auto * const bookmarkItem = dynamic_cast<BookmarkItem *>(item);
+                if (!bookmarkItem)
+                    return false;
+                bookmarkItem->setDescription(
+                            attributes.value(
+                                QStringLiteral("description")).toString());
+            }
+            return true;
         }
+
+        return false;
     }
 
 
 public: // fields:
 
     BookmarkFolder * m_rootItem;
-    QTimer m_saveTimer;
+    QFile m_journal;
+    int m_journalGeneration = 0;
+    int m_journalEntries = 0;
     static BtBookmarksModel * m_defaultModel;
 
     Q_DECLARE_PUBLIC(BtBookmarksModel)
@@ -590,7 +834,9 @@ QString BookmarkItem::toolTip() const {
     FilterOptions filterOptions = btConfig().getFilterOptions();
     filterOptions.footnotes = false;
     filterOptions.scriptureReferences = false;
-    CSwordBackend::instance().setFilterOptions(filterOptions);
+    CSwordBackend::FilterOptionsScope const filterOptionsScope(
+                CSwordBackend::instance(),
+                filterOptions);
 
     std::unique_ptr<CSwordKey> k(m->createKey());
     BT_ASSERT(k);
@@ -621,11 +867,6 @@ BtBookmarksModel::BtBookmarksModel(QString const & fileName, QObject * parent)
 { load(fileName); }
 
 BtBookmarksModel::~BtBookmarksModel() {
-    Q_D(BtBookmarksModel);
-
-    if(d->m_saveTimer.isActive())
-        save();
-
     delete d_ptr;
 }
 
@@ -709,15 +950,12 @@ bool BtBookmarksModel::setData(const QModelIndex & index, const QVariant & val,
         case Qt::EditRole:
         {
             i->setText(val.toString());
-            if(dynamic_cast<BookmarkFolder *>(i) || dynamic_cast<BookmarkItem *>(i))
-                d->needSave();
+            d->journalSet(i, QStringLiteral("text"), i->text());
             return true;
         }
         case Qt::ToolTipRole:
         {
             i->setToolTip(val.toString());
-            if(dynamic_cast<BookmarkFolder *>(i) || dynamic_cast<BookmarkItem *>(i))
-                d->needSave();
             return true;
         }
     }
@@ -730,6 +968,8 @@ bool BtBookmarksModel::removeRows(int row, int count, const QModelIndex & parent
 
     BT_ASSERT(rowCount(parent) >= row + count);
 
+    d->journalRemove(d->item(parent), row, count);
+
     beginRemoveRows(parent, row, row + count - 1);
 
     for(int i = 0; i < count; ++i) {
@@ -737,8 +977,6 @@ bool BtBookmarksModel::removeRows(int row, int count, const QModelIndex & parent
     }
     endRemoveRows();
 
-    d->needSave();
-
     return true;
 }
 
@@ -762,20 +1000,13 @@ bool BtBookmarksModel::insertRows(int row, int count, const QModelIndex &parent)
 bool BtBookmarksModel::save(QString fileName, const QModelIndex & rootItem) {
     Q_D(BtBookmarksModel);
 
-    QString const serializedTree(
-            d->serializeTreeFromRootItem(d->item(rootItem)));
-    if (fileName.isEmpty())
+    if (fileName.isEmpty()) {
+        if (d->m_defaultModel == this && !rootItem.isValid())
+            return d->compact();
         fileName = BtBookmarksModelPrivate::defaultBookmarksFile();
+    }
 
-    util::tool::savePlainFile(
-                fileName,
-                serializedTree,
-                QTextCodec::codecForName(QByteArrayLiteral("UTF-8")));
-
-    if(d->m_saveTimer.isActive())
-        d->m_saveTimer.stop();
-
-    return true;
+    return BtBookmarksModelPrivate::saveTree(fileName, d->item(rootItem));
 }
 
 bool BtBookmarksModel::load(QString fileName, const QModelIndex & rootItem) {
@@ -784,23 +1015,35 @@ bool BtBookmarksModel::load(QString fileName, const QModelIndex & rootItem) {
     BookmarkItemBase * i = d->item(rootItem);
     QList<BookmarkItemBase *> items = d->loadTree(fileName);
 
-    if(!rootItem.isValid() && fileName.isEmpty()) {
+    bool const loadDefault = !rootItem.isValid() && fileName.isEmpty();
+    bool journalReplayed = true;
+    if (loadDefault) {
         BT_ASSERT(!d->m_defaultModel && "Only one default model allowed!");
-        BT_CONNECT(&d->m_saveTimer, &QTimer::timeout,
-                   this,            &BtBookmarksModel::slotSave);
-        d->m_defaultModel = this;
+        BookmarkFolder root(QString{});
+        root.insertChildren(0, items);
+        journalReplayed = d->replayJournal(root);
+        items = root.children();
+        root.children().clear();
     }
 
-    if(items.size() == 0)
-        return false;
+    if(items.size() > 0) {
+        beginInsertRows(rootItem, i->childCount(), i->childCount() + items.size() - 1);
 
-    beginInsertRows(rootItem, i->childCount(), i->childCount() + items.size() - 1);
+        int const row = i->childCount();
+        i->insertChildren(row, items);
 
-    i->insertChildren(i->childCount(), items);
+        endInsertRows();
 
-    endInsertRows();
+        d->journalInsert(i, row, items);
+    }
 
-    return true;
+    if (loadDefault) {
+        d->m_defaultModel = this;
+        if (!journalReplayed || !d->openJournal())
+            d->compact();
+    }
+
+    return items.size() > 0;
 }
 
 bool BtBookmarksModel::isFolder(const QModelIndex &index) const
@@ -862,7 +1105,7 @@ QModelIndexList BtBookmarksModel::copyItems(int row, const QModelIndex & parent,
 
     endInsertRows();
 
-    d->needSave();
+    d->journalInsert(d->item(parent), row, newList);
 
     QModelIndexList result;
     for(int i = 0; i < newList.size(); ++i) {
@@ -904,7 +1147,7 @@ void BtBookmarksModel::setDescription(const QModelIndex &index, const QString &d
 
     if (BookmarkItem * const i = d->itemAs<BookmarkItem>(index)) {
         i->setDescription(description);
-        d->needSave();
+        d->journalSet(i, QStringLiteral("description"), description);
     }
 }
 
@@ -927,7 +1170,7 @@ QModelIndex BtBookmarksModel::addBookmark(int const row,
 
         endInsertRows();
 
-        d->needSave();
+        d->journalInsert(i, r, {c});
 
         return createIndex(c->index(), 0, c);
     }
@@ -946,7 +1189,7 @@ QModelIndex BtBookmarksModel::addFolder(int row, const QModelIndex &parent, cons
 
         endInsertRows();
 
-        d->needSave();
+        d->journalInsert(i, row, {c});
 
         return createIndex(c->index(), 0, c);
     }
@@ -1012,9 +1255,11 @@ void BtBookmarksModel::sortItems(QModelIndex const & parent,
                         changePersistentIndex(createIndex(ii, 0, iii), createIndex(i, 0, iii));
             }
             Q_EMIT layoutChanged();
-
-            d->needSave();
         }
+
+        // Sorting changes too many rows to be journaled:
+        if (d->m_defaultModel == this)
+            d->compact();
     }
 }
 
@@ -19,8 +19,10 @@ class BtBookmarksModelPrivate;
 class CSwordModuleInfo;
 
 /**
-  Model to load and display bookmarks. It is saved periodically if it was loaded
-  from default bookmarks file. No more one such model allowed at time.
+  Model to load and display bookmarks. If it was loaded from the default
+  bookmarks file, every change is appended to a journal beside that file right
+  away, and the file itself is only rewritten once the journal has grown long.
+  No more one such model allowed at time.
 */
 class BtBookmarksModel: public QAbstractItemModel {
 
@@ -137,7 +139,8 @@ public Q_SLOTS:
       \brief Save bookmarks or specified branch to file.
 
       \param[in] fileName use file or save to the default bookmarks file if it is empty,
-          file will be overwriten if it exists.
+          file will be overwriten if it exists. Saving all bookmarks of the
+          default model to the default bookmarks file also clears its journal.
       \param[in] rootItem is used to save specified branch of bookmark items or save all
           bookmarks if it is empty.
       \returns true if success.
@@ -154,10 +157,6 @@ public Q_SLOTS:
     */
     bool load(QString fileName = QString(), const QModelIndex & rootItem = QModelIndex());
 
-private:
-
-    bool slotSave() { return save(); }
-
 private: // fields:
     Q_DECLARE_PRIVATE(BtBookmarksModel)
     BtBookmarksModelPrivate * const d_ptr;
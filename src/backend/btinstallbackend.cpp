@@ -13,12 +13,20 @@
 #include "btinstallbackend.h"
 
 #include <QByteArray>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
 #include <QDebug>
 #include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QIODevice>
+#include <QSaveFile>
 #include <type_traits>
 #include <utility>
 #include "../util/btassert.h"
 #include "../util/directory.h"
+#include "../util/tool.h"
 #include "managers/cswordbackend.h"
 #include "btinstallmgr.h"
 
@@ -35,6 +43,51 @@
 
 using namespace sword;
 
+// Change it once the format changed to make all systems rebuild their caches
+#define CATALOG_CACHE_FORMAT "1"
+
+namespace {
+
+/** \returns the catalog entry for the given configuration file of a work. */
+BtInstallBackend::CatalogEntry readCatalogEntry(QString const & confFile) {
+    SWConfig config(confFile.toLocal8Bit().constData());
+    auto const & sections = config.getSections();
+    if (sections.empty())
+        return {};
+    auto const & section = sections.begin()->second;
+    auto const value =
+            [&section](char const * const key) {
+                auto const it = section.find(key);
+                return (it != section.end())
+                       ? QString::fromUtf8(it->second.c_str())
+                       : QString();
+            };
+    auto const hasFeature =
+            [&section](char const * const feature) {
+                auto const range = section.equal_range("Feature");
+                for (auto it = range.first; it != range.second; ++it)
+                    if (it->second == feature)
+                        return true;
+                return false;
+            };
+
+    BtInstallBackend::CatalogEntry entry;
+    entry.name = QString::fromUtf8(sections.begin()->first.c_str());
+    entry.version = value("Version");
+
+    // Same as for CSwordModuleInfo::language(), Sword defaults to English:
+    auto language = value("Lang");
+    if (value("Category") == QStringLiteral("Glossaries")
+        || hasFeature("Glossary"))
+        language = value("GlossaryFrom");
+    else if (language.isEmpty())
+        language = QStringLiteral("en");
+    entry.language = util::tool::fixSwordBcp47(std::move(language));
+    return entry;
+}
+
+} // anonymous namespace
+
 namespace BtInstallBackend {
 
 /** Adds the source described by Source to the backend. */
@@ -193,4 +246,79 @@ std::unique_ptr<CSwordBackend> backend(sword::InstallSource const & is) {
     return ret;
 }
 
+std::vector<CatalogEntry> catalog(sword::InstallSource const & is) {
+    namespace DU = util::directory;
+
+    QDir const modsDir(QStringLiteral("%1/mods.d")
+                       .arg(QString::fromLocal8Bit(isRemote(is)
+                                                   ? is.localShadow.c_str()
+                                                   : is.directory.c_str())));
+    auto const confFiles =
+            modsDir.entryInfoList({QStringLiteral("*.conf")},
+                                  QDir::Files | QDir::Readable,
+                                  QDir::Name);
+
+    // Refreshing the source changes the time of the directory or of its files:
+    auto timestamp = QFileInfo(modsDir.absolutePath()).lastModified();
+    for (auto const & confFile : confFiles)
+        timestamp = qMax(timestamp, confFile.lastModified());
+    auto const sourceState =
+            QStringLiteral("%1 %2").arg(timestamp.toString(Qt::ISODateWithMs),
+                                        QString::number(confFiles.size()));
+
+    auto const cachePath =
+            QStringLiteral("%1/%2.catalog")
+            .arg(DU::getUserCacheDir().absolutePath(),
+                 QString::fromLatin1(
+                     QCryptographicHash::hash(
+                         modsDir.absolutePath().toUtf8(),
+                         QCryptographicHash::Md5).toHex()));
+
+    QFile cacheFile(cachePath);
+
+    std::vector<CatalogEntry> entries;
+    if (cacheFile.open(QIODevice::ReadOnly)) {
+        QDataStream s(&cacheFile);
+        QString cacheVersion, dataStreamVersion, cachedSourceState;
+        s >> cacheVersion >> dataStreamVersion >> cachedSourceState;
+        if (cacheVersion == QStringLiteral(CATALOG_CACHE_FORMAT)
+            && dataStreamVersion == QString::number(s.version())
+            && cachedSourceState == sourceState)
+        {
+            quint32 count;
+            s >> count;
+            if (count <= static_cast<quint32>(confFiles.size()))
+                entries.resize(count);
+            for (auto & entry : entries)
+                s >> entry.name >> entry.language >> entry.version;
+            if (s.status() == QDataStream::Ok)
+                return entries;
+            entries.clear();
+        }
+        cacheFile.close();
+    }
+
+    entries.reserve(static_cast<std::size_t>(confFiles.size()));
+    for (auto const & confFile : confFiles) {
+        auto entry = readCatalogEntry(confFile.absoluteFilePath());
+        if (!entry.name.isEmpty())
+            entries.emplace_back(std::move(entry));
+    }
+
+    // Write atomically, lest readers or a crash leave a partial cache behind:
+    QSaveFile saveFile(cachePath);
+    if (saveFile.open(QIODevice::WriteOnly)) {
+        QDataStream s(&saveFile);
+        s << QStringLiteral(CATALOG_CACHE_FORMAT)
+          << QString::number(s.version())
+          << sourceState
+          << static_cast<quint32>(entries.size());
+        for (auto const & entry : entries)
+            s << entry.name << entry.language << entry.version;
+        if (s.status() == QDataStream::Ok)
+            saveFile.commit();
+    }
+    return entries;
+}
+
 } // namespace BtInstallBackend
@@ -15,6 +15,7 @@
 #include <memory>
 #include <QString>
 #include <QStringList>
+#include <vector>
 
 
 class CSwordBackend;
@@ -45,4 +46,19 @@ QString configFilename();
 /** Returns backend Sword manager for the source. */
 std::unique_ptr<CSwordBackend> backend(sword::InstallSource const & is);
 
+/** \brief The metadata of a work available from an install source. */
+struct CatalogEntry {
+    QString name;
+    QString language; ///< The abbreviation of the language of the work.
+    QString version;
+};
+
+/**
+  \brief Lists the works available from the source without loading them.
+
+  The list is read from the configuration files of the works and cached until
+  the source is refreshed, i.e. until any of these files changes.
+*/
+std::vector<CatalogEntry> catalog(sword::InstallSource const & is);
+
 } // namespace BtInstallBackend
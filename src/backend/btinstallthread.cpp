@@ -16,6 +16,7 @@
 #include <QDebug>
 #include <QByteArray>
 #include <QDir>
+#include <QList>
 #include <QString>
 #include <QVariant>
 #include "btinstallbackend.h"
@@ -41,6 +42,11 @@ inline bool runMkdir(QDir & dir, const QString & dirName) {
     return true;
 }
 
+sword::InstallSource moduleSource(CSwordModuleInfo const & module) {
+    return BtInstallBackend::source(
+                module.property("installSourceName").toString());
+}
+
 }
 
 void BtInstallThread::run() {
@@ -54,55 +60,57 @@ void BtInstallThread::run() {
         return;
     }
 
+    /* All installs share the manager for the destination path. It is not
+       refreshed after every install, since CSwordBackend::reloadModules() is
+       run once after all works have been installed anyway. Sword is not
+       thread-safe, e.g. its FileMgr, hence the works are installed one after
+       another: */
+    sword::SWMgr destinationMgr(m_destination.toLatin1());
     for (m_currentModuleIndex = 0;
          m_currentModuleIndex < m_modules.size();
          ++m_currentModuleIndex)
     {
-        installModule();
-        if (m_stopRequested.load(std::memory_order_relaxed))
+        if (stopRequested())
+            break;
+        Q_EMIT preparingInstall(m_currentModuleIndex);
+
+        // Check whether it's an update. If yes, remove existing module first:
+        /// \todo silently removing without undo if the user cancels the update is WRONG!!!
+        if (!removeModule(m_currentModuleIndex) && stopRequested())
             break;
+        installModule(m_currentModuleIndex, destinationMgr);
     }
 }
 
-void BtInstallThread::installModule() {
-    Q_EMIT preparingInstall(m_currentModuleIndex);
-
-    const CSwordModuleInfo * const module = m_modules.at(m_currentModuleIndex);
-
-    QVariant vModuleName = module->property("installSourceName");
-    QString moduleName = vModuleName.toString();
-    sword::InstallSource installSource = BtInstallBackend::source(moduleName);
-
-    // Check whether it's an update. If yes, remove existing module first:
-    /// \todo silently removing without undo if the user cancels the update is WRONG!!!
-    if (!removeModule() && m_stopRequested.load(std::memory_order_relaxed))
-        return;
+void BtInstallThread::installModule(int const moduleIndex,
+                                    sword::SWMgr & destinationMgr)
+{
+    const CSwordModuleInfo * const module = m_modules.at(moduleIndex);
+    sword::InstallSource installSource = moduleSource(*module);
 
-    // manager for the destination path
-    sword::SWMgr lMgr(m_destination.toLatin1());
     if (BtInstallBackend::isRemote(installSource)) {
-        int status = m_iMgr.installModule(&lMgr,
+        int status = m_iMgr.installModule(&destinationMgr,
                                           nullptr,
                                           module->name().toLatin1(),
                                           &installSource);
         if (status == 0) {
-            Q_EMIT statusUpdated(m_currentModuleIndex, 100);
+            Q_EMIT statusUpdated(moduleIndex, 100);
         } else {
             qWarning() << "Error with install: " << status
                        << "module:" << module->name();
         }
-        Q_EMIT installCompleted(m_currentModuleIndex, status == 0);
+        Q_EMIT installCompleted(moduleIndex, status == 0);
     } else { // Local source
-        int status = m_iMgr.installModule(&lMgr,
+        int status = m_iMgr.installModule(&destinationMgr,
                                           installSource.directory.c_str(),
                                           module->name().toLatin1());
         if (status == 0) {
-            Q_EMIT statusUpdated(m_currentModuleIndex, 100);
+            Q_EMIT statusUpdated(moduleIndex, 100);
         } else if (status != -1) {
             qWarning() << "Error with install: " << status
                        << "module:" << module->name();
         }
-        Q_EMIT installCompleted(m_currentModuleIndex, status == 0);
+        Q_EMIT installCompleted(moduleIndex, status == 0);
     }
 }
 
@@ -114,8 +122,8 @@ void BtInstallThread::slotDownloadStarted() {
     Q_EMIT downloadStarted(m_currentModuleIndex);
 }
 
-bool BtInstallThread::removeModule() {
-    CSwordModuleInfo * const installedModule = m_modules.at(m_currentModuleIndex);
+bool BtInstallThread::removeModule(int const moduleIndex) {
+    CSwordModuleInfo * const installedModule = m_modules.at(moduleIndex);
     CSwordModuleInfo const * m =
             CSwordBackend::instance().findModuleByName(installedModule->name());
     std::unique_ptr<CSwordBackend const> backend;
@@ -24,6 +24,7 @@
 
 
 class CSwordModuleInfo;
+namespace sword { class SWMgr; }
 
 class BtInstallThread: public QThread {
 
@@ -70,8 +71,11 @@ class BtInstallThread: public QThread {
 
     private: // methods:
 
-        void installModule();
-        bool removeModule();
+        bool stopRequested() const noexcept
+        { return m_stopRequested.load(std::memory_order_relaxed); }
+
+        void installModule(int moduleIndex, sword::SWMgr & destinationMgr);
+        bool removeModule(int moduleIndex);
 
     private Q_SLOTS:
 
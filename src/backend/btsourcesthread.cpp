@@ -14,19 +14,129 @@
 
 #include <cstddef>
 #include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QIODevice>
 #include <QList>
 #include <QString>
 #include <QStringList>
-#include <memory>
 #include <utility>
+#include <vector>
 #include "../util/btassert.h"
 #include "btinstallbackend.h"
 #include "btinstallmgr.h"
 
 // Sword includes:
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsuggest-override"
+#pragma GCC diagnostic ignored "-Wzero-as-null-pointer-constant"
+#include <filemgr.h>
 #include <installmgr.h>
+#include <zipcomprs.h>
+#pragma GCC diagnostic pop
 
 
+namespace {
+
+/** \returns whether both files exist and have the same contents. */
+bool sameFileContents(QString const & filename1, QString const & filename2) {
+    QFile file1(filename1);
+    QFile file2(filename2);
+    if (!file1.open(QIODevice::ReadOnly) || !file2.open(QIODevice::ReadOnly))
+        return false;
+    return file1.size() == file2.size() && file1.readAll() == file2.readAll();
+}
+
+} // anonymous namespace
+
+bool BtSourcesThread::refreshLocalSource(
+        sword::InstallSource const & source)
+{
+    /* Works of local libraries are read directly from their directory, hence
+       there is nothing to transfer. Only the catalog of the works is read
+       again if any of their configuration files has changed: */
+    QString const modsDir =
+            QString::fromLocal8Bit(source.directory.c_str())
+            + QStringLiteral("/mods.d");
+    if (!QDir(modsDir).exists()) {
+        qWarning() << "Local library" << source.caption.c_str()
+                   << "has no directory" << modsDir;
+        return false;
+    }
+    BtInstallBackend::catalog(source);
+    return true;
+}
+
+bool BtSourcesThread::refreshRemoteSource(BtInstallMgr & iMgr,
+                                          sword::InstallSource & source)
+{
+    /* Sword keeps the archive of the configuration files of the works after
+       unpacking it. If the archive on the server is the same, the unpacked
+       files are still up to date and unpacking is skipped. This also keeps
+       the catalog of the library cached, see BtInstallBackend::catalog(): */
+    QString const shadowPath =
+            QString::fromLocal8Bit(source.localShadow.c_str());
+    QString const modsDir = shadowPath + QStringLiteral("/mods.d");
+    QString const archive = shadowPath + QStringLiteral("/mods.d.tar.gz");
+    QString const newArchive = archive + QStringLiteral(".new");
+    QDir().mkpath(shadowPath);
+    bool const haveArchive =
+            !iMgr.remoteCopy(&source,
+                             "mods.d.tar.gz",
+                             newArchive.toLocal8Bit().constData());
+    if (haveArchive
+        && sameFileContents(archive, newArchive)
+        && QDir(modsDir).exists())
+    {
+        QFile::remove(newArchive);
+        qDebug() << "Remote library" << source.caption.c_str()
+                 << "has not changed";
+        return true;
+    }
+
+    if (shouldStop()) {
+        QFile::remove(newArchive);
+        return false;
+    }
+
+    // Same as InstallMgr::refreshRemoteSource(), without downloading again:
+    QDir(modsDir).removeRecursively();
+    QDir().mkpath(modsDir);
+    if (haveArchive) {
+        QFile::remove(archive);
+        if (!QFile::rename(newArchive, archive)) {
+            QFile::remove(newArchive);
+            return false;
+        }
+        auto * const fileMgr = sword::FileMgr::getSystemFileMgr();
+        auto * const fd = fileMgr->open(archive.toLocal8Bit().constData(),
+                                        sword::FileMgr::RDONLY);
+        if (!fd)
+            return false;
+        sword::ZipCompress::unTarGZ(fd->getFd(),
+                                    shadowPath.toLocal8Bit().constData());
+        fileMgr->close(fd);
+        return true;
+    }
+
+    // Libraries without an archive provide the files one by one:
+    QFile::remove(newArchive);
+    return !iMgr.remoteCopy(&source,
+                            "mods.d",
+                            modsDir.toLocal8Bit().constData(),
+                            true,
+                            ".conf");
+}
+
+bool BtSourcesThread::refreshSource(BtInstallMgr & iMgr,
+                                    QString const & sourceName)
+{
+    sword::InstallSource source = BtInstallBackend::source(sourceName);
+    return BtInstallBackend::isRemote(source)
+           ? refreshRemoteSource(iMgr, source)
+           : refreshLocalSource(source);
+}
+
 void BtSourcesThread::run() {
     Q_EMIT percentComplete(0);
     Q_EMIT showMessage(tr("Getting Library List"));
@@ -39,11 +149,13 @@ void BtSourcesThread::run() {
         return;
     }
 
+    /* The sources are refreshed one after another, because Sword's file
+       manager and configuration parsing are not thread-safe: */
     QStringList const sourceNames = BtInstallBackend::sourceNameList();
     auto const sourceCount = sourceNames.count();
     BT_ASSERT(sourceCount >= 0);
-    auto const failedSources(std::make_unique<int[]>(sourceCount));
-    std::size_t numFailedSources = 0u;
+    std::vector<bool> failedSources(static_cast<std::size_t>(sourceCount),
+                                    false);
     BtInstallMgr iMgr;
     for (int i = 0; i < sourceCount; ++i) {
         if (shouldStop()) {
@@ -53,30 +165,32 @@ void BtSourcesThread::run() {
         QString const & sourceName = sourceNames[i];
         Q_EMIT showMessage(
                     tr("Updating remote library \"%1\"").arg(sourceName));
-        {
-            sword::InstallSource source = BtInstallBackend::source(sourceName);
-            if (iMgr.refreshRemoteSource(&source)) {
-                failedSources[numFailedSources] = i;
-                ++numFailedSources;
-            }
-        }
+        bool const updated = refreshSource(iMgr, sourceName);
+        if (!updated && !shouldStop())
+            Q_EMIT showMessage(
+                    tr("Failed to update remote library \"%1\"")
+                    .arg(sourceName));
+        failedSources[static_cast<std::size_t>(i)] = !updated;
         Q_EMIT percentComplete(
                     static_cast<int>(10 + 90 * ((i + 1.0) / sourceCount)));
     }
+
+    if (shouldStop()) {
+        Q_EMIT showMessage(tr("Updating stopped"));
+        return;
+    }
     Q_EMIT percentComplete(100);
-    if (numFailedSources <= 0) {
+
+    QStringList failedSourceNames;
+    for (int i = 0; i < sourceCount; ++i)
+        if (failedSources[static_cast<std::size_t>(i)])
+            failedSourceNames.append(sourceNames[i]);
+    if (failedSourceNames.isEmpty()) {
         Q_EMIT showMessage(tr("Remote libraries have been updated."));
-        m_finishedSuccessfully.store(true, std::memory_order_release);
     } else {
-        QString msg = tr("The following remote libraries failed to update: ");
-        for (std::size_t i = 0;;) {
-            msg += sourceNames[failedSources[i]];
-            if (++i >= numFailedSources)
-                break;
-            static auto const separator = QStringLiteral(", ");
-            msg.append(separator);
-        }
-        Q_EMIT showMessage(std::move(msg));
-        m_finishedSuccessfully.store(true, std::memory_order_release);
+        Q_EMIT showMessage(
+                tr("The following remote libraries failed to update: ")
+                + failedSourceNames.join(QStringLiteral(", ")));
     }
+    m_finishedSuccessfully.store(true, std::memory_order_release);
 }
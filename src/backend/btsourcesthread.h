@@ -19,6 +19,9 @@
 #include <QString>
 
 
+class BtInstallMgr;
+namespace sword { class InstallSource; }
+
 class BtSourcesThread: public QThread {
 
     Q_OBJECT
@@ -50,6 +53,16 @@ private: // methods:
     bool shouldStop() const noexcept
     { return m_stop.load(std::memory_order_acquire); }
 
+    /** \returns whether the library with the given name was updated. */
+    bool refreshSource(BtInstallMgr & iMgr, QString const & sourceName);
+
+    /** \returns whether the local library was updated. */
+    bool refreshLocalSource(sword::InstallSource const & source);
+
+    /** \returns whether the remote library was updated. */
+    bool refreshRemoteSource(BtInstallMgr & iMgr,
+                             sword::InstallSource & source);
+
 private: // fields:
 
     std::atomic<bool> m_stop;
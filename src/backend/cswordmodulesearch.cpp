@@ -40,7 +40,9 @@ Results search(QString const & searchText,
                           [](auto const * const m) { return m->hasIndex(); }));
 
     /// \todo What is the purpose of the following statement?
-    CSwordBackend::instance().setFilterOptions(btConfig().getFilterOptions());
+    CSwordBackend::FilterOptionsScope const filterOptionsScope(
+                CSwordBackend::instance(),
+                btConfig().getFilterOptions());
 
     // Search module-by-module:
     Results r;
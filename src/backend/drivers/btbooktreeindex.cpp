@@ -0,0 +1,183 @@
+/*********
+*
+* In the name of the Father, and of the Son, and of the Holy Spirit.
+*
+* This file is part of BibleTime's source code, https://bibletime.info/
+*
+* Copyright 1999-2021 by the BibleTime developers.
+* The BibleTime source code is licensed under the GNU General Public License
+* version 2.0.
+*
+**********/
+
+#include "btbooktreeindex.h"
+
+#include <QDataStream>
+#include <QTextCodec>
+#include <QtGlobal>
+#include <utility>
+#include "../../util/cp1252.h"
+
+// Sword includes:
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wextra-semi"
+#pragma GCC diagnostic ignored "-Wsuggest-override"
+#pragma GCC diagnostic ignored "-Wzero-as-null-pointer-constant"
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wsuggest-destructor-override"
+#endif
+#include <swkey.h>
+#include <treekeyidx.h>
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+#pragma GCC diagnostic pop
+
+
+BtBookTreeIndex::BtBookTreeIndex(sword::TreeKeyIdx const & tree,
+                                 bool const isUnicode)
+{
+    sword::TreeKeyIdx key(tree);
+    m_nodes.resize(static_cast<std::size_t>(indexFileSize(key)));
+
+    key.root();
+    appendNode(0, -1, QString());
+
+    auto const localName =
+            [&key, isUnicode]() {
+                if (isUnicode)
+                    return QString::fromUtf8(key.getLocalName());
+                return util::cp1252().toUnicode(key.getLocalName());
+            };
+
+    // Depth-first walk, parents holds the ancestors of the current node:
+    std::vector<int> parents{0};
+    for (bool atNode = key.firstChild();;) {
+        if (atNode) {
+            auto const index = static_cast<int>(key.getOffset() / 4u);
+            if (index <= 0 || index >= size() || contains(index))
+                return; // Broken index file, keep what was walked so far
+            appendNode(index, parents.back(), localName());
+            m_depth = qMax(m_depth, static_cast<int>(parents.size()));
+            if (key.firstChild()) {
+                parents.push_back(index);
+            } else {
+                atNode = key.nextSibling();
+            }
+        } else {
+            if (parents.size() <= 1u)
+                return;
+            parents.pop_back();
+            key.parent();
+            atNode = key.nextSibling();
+        }
+    }
+}
+
+std::unique_ptr<BtBookTreeIndex> BtBookTreeIndex::load(QDataStream & stream,
+                                                       int const size)
+{
+    if (size <= 0)
+        return nullptr;
+    std::unique_ptr<BtBookTreeIndex> r(new BtBookTreeIndex);
+    r->m_nodes.resize(static_cast<std::size_t>(size));
+
+    // A rewritten index file usually changes in size:
+    qint32 indexFileSize;
+    qint32 depth;
+    qint32 nodeCount;
+    stream >> indexFileSize >> depth >> nodeCount;
+    if (stream.status() != QDataStream::Ok
+        || indexFileSize != size
+        || depth < 0
+        || nodeCount <= 0
+        || nodeCount > size)
+        return nullptr;
+    r->m_depth = depth;
+
+    // Nodes are stored in walking order, hence parents come before children:
+    for (qint32 i = 0; i < nodeCount; ++i) {
+        qint32 index;
+        qint32 parent;
+        QString name;
+        stream >> index >> parent >> name;
+        if (stream.status() != QDataStream::Ok)
+            return nullptr;
+        if (i == 0) {
+            if (index != 0 || parent != -1)
+                return nullptr;
+        } else if (index <= 0
+                   || index >= size
+                   || r->contains(index)
+                   || !r->contains(parent))
+        {
+            return nullptr;
+        }
+        r->appendNode(index, parent, std::move(name));
+    }
+    return r;
+}
+
+void BtBookTreeIndex::save(QDataStream & stream) const {
+    std::vector<int> order;
+    order.reserve(m_nodes.size());
+    order.push_back(0);
+    for (std::size_t i = 0u; i < order.size(); ++i)
+        for (int const child : node(order[i]).children)
+            order.push_back(child);
+
+    stream << static_cast<qint32>(size())
+           << static_cast<qint32>(m_depth)
+           << static_cast<qint32>(order.size());
+    for (int const index : order) {
+        auto const & n = node(index);
+        stream << static_cast<qint32>(index)
+               << static_cast<qint32>(n.parent)
+               << n.name;
+    }
+}
+
+QString BtBookTreeIndex::path(int index) const {
+    QString r;
+    for (;;) {
+        auto const & n = node(index);
+        if (n.parent < 0)
+            return r;
+        r.prepend(n.name);
+        r.prepend('/');
+        index = n.parent;
+    }
+}
+
+int BtBookTreeIndex::indexOf(QString const & path) const {
+    if (m_pathIndexes.isEmpty()) {
+        m_pathIndexes.reserve(size());
+        for (int i = 0; i < size(); ++i)
+            if (contains(i))
+                m_pathIndexes.insert(this->path(i), i);
+    }
+    return m_pathIndexes.value(path, -1);
+}
+
+int BtBookTreeIndex::indexFileSize(sword::TreeKeyIdx const & tree) {
+    sword::TreeKeyIdx key(tree);
+    key.setPosition(sword::BOTTOM);
+    return static_cast<int>(key.getOffset() / 4u) + 1;
+}
+
+void BtBookTreeIndex::appendNode(int const index,
+                                 int const parent,
+                                 QString name)
+{
+    auto & n = m_nodes[static_cast<std::size_t>(index)];
+    n.parent = parent;
+    n.name = std::move(name);
+    if (parent < 0) {
+        n.row = 0;
+    } else {
+        auto & siblings = m_nodes[static_cast<std::size_t>(parent)].children;
+        n.row = static_cast<int>(siblings.size());
+        siblings.push_back(index);
+    }
+}
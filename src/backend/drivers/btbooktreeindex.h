@@ -0,0 +1,109 @@
+/*********
+*
+* In the name of the Father, and of the Son, and of the Holy Spirit.
+*
+* This file is part of BibleTime's source code, https://bibletime.info/
+*
+* Copyright 1999-2021 by the BibleTime developers.
+* The BibleTime source code is licensed under the GNU General Public License
+* version 2.0.
+*
+**********/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <QHash>
+#include <QString>
+#include <vector>
+
+
+class QDataStream;
+namespace sword { class TreeKeyIdx; }
+
+/**
+  \brief The structure of the tree of a generic book.
+
+  Nodes are identified by their index, which is the offset of their tree key
+  divided by 4. The root node has the index 0. Indexes of entries in the index
+  file which are not reachable from the root are not contained in the tree.
+*/
+class BtBookTreeIndex {
+
+public: // types:
+
+    struct Node {
+        int parent = -1; ///< The index of the parent node, -1 for the root.
+        int row = -1; ///< The position among the siblings of the node.
+        QString name; ///< The local name of the node.
+        std::vector<int> children;
+    };
+
+public: // methods:
+
+    /**
+      \brief Walks the whole tree of the given key.
+      \param[in] tree The tree key, its position is not changed.
+      \param[in] isUnicode Whether the names of the nodes are in UTF-8.
+    */
+    BtBookTreeIndex(sword::TreeKeyIdx const & tree, bool isUnicode);
+
+    /**
+      \brief Reads an index written by save().
+      \param[in] stream The stream to read from.
+      \param[in] size The number of entries in the index file of the book.
+      \returns the index or nullptr if the stream did not hold a valid index
+               saved for an index file of the same size.
+    */
+    static std::unique_ptr<BtBookTreeIndex> load(QDataStream & stream,
+                                                 int size);
+
+    void save(QDataStream & stream) const;
+
+    /** \returns the number of entries in the index file of the book. */
+    int size() const noexcept { return static_cast<int>(m_nodes.size()); }
+
+    /** \returns the maximal depth of sections and subsections. */
+    int depth() const noexcept { return m_depth; }
+
+    /** \returns whether the given index refers to a node of the tree. */
+    bool contains(int const index) const noexcept {
+        return index >= 0
+               && index < size()
+               && m_nodes[static_cast<std::size_t>(index)].row >= 0;
+    }
+
+    /** \pre contains(index) */
+    Node const & node(int const index) const
+    { return m_nodes[static_cast<std::size_t>(index)]; }
+
+    /**
+      \returns the full key of the node with the given index, as returned by
+               CSwordTreeKey::key().
+      \pre contains(index)
+    */
+    QString path(int index) const;
+
+    /**
+      \returns the index of the node with the given full key or -1 if there is
+               no such node.
+    */
+    int indexOf(QString const & path) const;
+
+    /** \returns the number of entries in the index file of the given tree. */
+    static int indexFileSize(sword::TreeKeyIdx const & tree);
+
+private: // methods:
+
+    BtBookTreeIndex() = default;
+
+    void appendNode(int index, int parent, QString name);
+
+private: // fields:
+
+    std::vector<Node> m_nodes;
+    int m_depth = 0;
+    mutable QHash<QString, int> m_pathIndexes;
+
+};
@@ -0,0 +1,339 @@
+/*********
+*
+* In the name of the Father, and of the Son, and of the Holy Spirit.
+*
+* This file is part of BibleTime's source code, https://bibletime.info/
+*
+* Copyright 1999-2021 by the BibleTime developers.
+* The BibleTime source code is licensed under the GNU General Public License
+* version 2.0.
+*
+**********/
+
+#include "btzversereader.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <list>
+#include <map>
+#include <mutex>
+#include <QtEndian>
+#include <tuple>
+#include <utility>
+
+// Sword includes:
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wextra-semi"
+#pragma GCC diagnostic ignored "-Wsuggest-override"
+#pragma GCC diagnostic ignored "-Wzero-as-null-pointer-constant"
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wsuggest-destructor-override"
+#endif
+#include <swmodule.h>
+#include <versekey.h>
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+#pragma GCC diagnostic pop
+
+
+namespace {
+
+/**
+  \brief The cache of decompressed blocks shared by all readers.
+
+  Blocks are evicted in least recently used order once the total size of the
+  cached blocks exceeds the budget.
+*/
+class BlockCache {
+
+public: // types:
+
+    /** The maximum size of all cached decompressed blocks in bytes. */
+    static constexpr std::size_t budget = 16u * 1024u * 1024u;
+
+    using Key = std::tuple<quint64, int, quint32>;
+    using Block = std::shared_ptr<QByteArray const>;
+
+public: // methods:
+
+    Block find(Key const & key) {
+        std::lock_guard const guard(m_mutex);
+        auto const it = m_index.find(key);
+        if (it == m_index.end())
+            return {};
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        return it->second->second;
+    }
+
+    Block insert(Key const & key, Block block) {
+        std::lock_guard const guard(m_mutex);
+        // Another thread might have decompressed the same block meanwhile:
+        if (auto const it = m_index.find(key); it != m_index.end())
+            return it->second->second;
+        m_size += static_cast<std::size_t>(block->size());
+        m_lru.emplace_front(key, std::move(block));
+        m_index.emplace(key, m_lru.begin());
+        evict();
+        return m_lru.front().second;
+    }
+
+private: // methods:
+
+    void evict() {
+        while (m_size > budget && !m_lru.empty()) {
+            m_size -= static_cast<std::size_t>(m_lru.back().second->size());
+            m_index.erase(m_lru.back().first);
+            m_lru.pop_back();
+        }
+    }
+
+private: // fields:
+
+    std::mutex m_mutex;
+    std::list<std::pair<Key, Block>> m_lru;
+    std::map<Key, decltype(m_lru)::iterator> m_index;
+    std::size_t m_size = 0u;
+
+};
+
+BlockCache & blockCache() {
+    static BlockCache cache;
+    return cache;
+}
+
+/** \returns the letter Sword uses in the file names for the block type. */
+char blockTypeLetter(char const * const blockType) {
+    if (!blockType || !std::strcmp(blockType, "CHAPTER"))
+        return 'c';
+    if (!std::strcmp(blockType, "BOOK"))
+        return 'b';
+    if (!std::strcmp(blockType, "VERSE"))
+        return 'v';
+    return '\0';
+}
+
+/** Normalizes line breaks and whitespace like sword::SWModule::prepText(). */
+void prepText(QByteArray & text) {
+    char * const data = text.data();
+    int to = 0;
+    bool space = false;
+    bool cr = false;
+    bool realData = false;
+    int newLines = 0;
+    for (int from = 0; from < text.size(); ++from) {
+        char const c = data[from];
+        if (c == '\n') {
+            if (!realData)
+                continue;
+            space = !cr;
+            cr = false;
+            if (++newLines > 1)
+                data[to++] = '\n';
+            continue;
+        }
+        if (c == '\r') {
+            if (!realData)
+                continue;
+            data[to++] = '\n';
+            space = false;
+            cr = true;
+            continue;
+        }
+        realData = true;
+        newLines = 0;
+        if (space) {
+            space = false;
+            if (c != ' ')
+                data[to++] = ' ';
+        }
+        data[to++] = c;
+    }
+    while (to > 1 && (data[to - 1] == '\n' || data[to - 1] == ' '))
+        --to;
+    text.truncate(to);
+}
+
+} // anonymous namespace
+
+BtZVerseReader::BtZVerseReader(QString const & path,
+                               char const blockType,
+                               bool const wideSizes)
+    : m_id(
+        []{
+            static std::atomic<quint64> lastId(0u);
+            return ++lastId;
+        }())
+    , m_wideSizes(wideSizes)
+{
+    mapTestament(m_testaments[0], path, "ot", blockType);
+    mapTestament(m_testaments[1], path, "nt", blockType);
+}
+
+BtZVerseReader::~BtZVerseReader() = default;
+
+std::unique_ptr<BtZVerseReader> BtZVerseReader::create(
+        sword::SWModule & module)
+{
+    auto const * const driver = module.getConfigEntry("ModDrv");
+    if (!driver)
+        return nullptr;
+    bool wideSizes;
+    if (!std::strcmp(driver, "zText") || !std::strcmp(driver, "zCom")) {
+        wideSizes = false;
+    } else if (!std::strcmp(driver, "zText4")
+               || !std::strcmp(driver, "zCom4"))
+    {
+        wideSizes = true;
+    } else {
+        return nullptr;
+    }
+
+    // Encrypted modules need the raw filters of Sword:
+    if (module.getConfigEntry("CipherKey"))
+        return nullptr;
+
+    // Sword defaults to LZSS, only ZIP is supported here:
+    auto const * const compressType = module.getConfigEntry("CompressType");
+    if (!compressType || std::strcmp(compressType, "ZIP"))
+        return nullptr;
+
+    auto const blockType =
+            blockTypeLetter(module.getConfigEntry("BlockType"));
+    if (!blockType)
+        return nullptr;
+
+    auto const * const path = module.getConfigEntry("AbsoluteDataPath");
+    if (!path)
+        return nullptr;
+
+    std::unique_ptr<BtZVerseReader> r(
+                new BtZVerseReader(QString::fromLocal8Bit(path),
+                                   blockType,
+                                   wideSizes));
+    for (auto const & testament : r->m_testaments)
+        if (testament.verseIndex.isOpen())
+            return r;
+    return nullptr;
+}
+
+bool BtZVerseReader::mapTestament(Testament & testament,
+                                  QString const & path,
+                                  char const * const testamentName,
+                                  char const blockType)
+{
+    auto const filePath =
+            [&](char const kind) {
+                return QStringLiteral("%1/%2.%3z%4")
+                        .arg(path,
+                             QLatin1String(testamentName),
+                             QLatin1Char(blockType),
+                             QLatin1Char(kind));
+            };
+    auto const map =
+            [](QFile & file, QString const & name, uchar const * & data) {
+                file.setFileName(name);
+                if (!file.open(QIODevice::ReadOnly))
+                    return false;
+                if (file.size() <= 0)
+                    return true; // Nothing to map, every lookup is out of range
+                data = file.map(0, file.size());
+                return data != nullptr;
+            };
+    if (map(testament.blockIndex, filePath('s'), testament.blockIndexData)
+        && map(testament.verseIndex, filePath('v'), testament.verseIndexData)
+        && map(testament.text, filePath('z'), testament.textData))
+        return true;
+    for (auto * const file
+         : {&testament.blockIndex, &testament.verseIndex, &testament.text})
+        file->close();
+    testament.blockIndexData = nullptr;
+    testament.verseIndexData = nullptr;
+    testament.textData = nullptr;
+    return false;
+}
+
+std::optional<QByteArray> BtZVerseReader::rawEntry(
+        sword::VerseKey const & key) const
+{
+    auto const testamentNumber = key.getTestament();
+    if (testamentNumber < 1 || testamentNumber > 2)
+        return std::nullopt;
+    auto const & testament = m_testaments[testamentNumber - 1];
+    if (!testament.verseIndex.isOpen())
+        return QByteArray(); // Like Sword, treat missing testaments as empty
+
+    // Find the verse in the verse index:
+    auto const recordSize = m_wideSizes ? 12u : 10u;
+    auto const offset =
+            static_cast<qint64>(key.getTestamentIndex()) * recordSize;
+    if (offset < 0 || offset + recordSize > testament.verseIndex.size())
+        return QByteArray();
+    auto const * const record = testament.verseIndexData + offset;
+    auto const blockNumber = qFromLittleEndian<quint32>(record);
+    auto const start = qFromLittleEndian<quint32>(record + 4);
+    auto const size = m_wideSizes
+                      ? qFromLittleEndian<quint32>(record + 8)
+                      : qFromLittleEndian<quint16>(record + 8);
+    if (!size)
+        return QByteArray();
+
+    auto const data = block(testamentNumber, blockNumber);
+    if (!data)
+        return std::nullopt;
+    if (start >= static_cast<quint32>(data->size()))
+        return QByteArray();
+
+    // Like Sword, stop at the first NUL character:
+    auto const * const entryStart = data->constData() + start;
+    auto const available = static_cast<quint32>(data->size()) - start;
+    auto const * const end = static_cast<char const *>(
+                std::memchr(entryStart, '\0', qMin(size, available)));
+    QByteArray r(entryStart,
+                 static_cast<int>(end
+                                  ? static_cast<quint32>(end - entryStart)
+                                  : qMin(size, available)));
+    prepText(r);
+    return r;
+}
+
+std::shared_ptr<QByteArray const> BtZVerseReader::block(
+        int const testamentNumber,
+        quint32 const blockNumber) const
+{
+    BlockCache::Key const key(m_id, testamentNumber, blockNumber);
+    auto & cache = blockCache();
+    if (auto r = cache.find(key))
+        return r;
+
+    // Find the compressed block in the block index:
+    auto const & testament = m_testaments[testamentNumber - 1];
+    auto const offset = static_cast<qint64>(blockNumber) * 12;
+    if (offset + 12 > testament.blockIndex.size())
+        return {};
+    auto const * const record = testament.blockIndexData + offset;
+    auto const start = qFromLittleEndian<quint32>(record);
+    auto const size = qFromLittleEndian<quint32>(record + 4);
+    auto const uncompressedSize = qFromLittleEndian<quint32>(record + 8);
+    if (static_cast<qint64>(start) + size > testament.text.size())
+        return {};
+
+    // Decompress outside of the lock, qUncompress() expects the size first:
+    QByteArray compressed;
+    compressed.reserve(static_cast<int>(size) + 4);
+    uchar sizeHeader[4];
+    qToBigEndian(uncompressedSize, sizeHeader);
+    compressed.append(reinterpret_cast<char const *>(sizeHeader), 4);
+    compressed.append(
+                reinterpret_cast<char const *>(testament.textData + start),
+                static_cast<int>(size));
+    auto uncompressed = qUncompress(compressed);
+    if (uncompressed.isEmpty() && uncompressedSize)
+        return {};
+    return cache.insert(
+                key,
+                std::make_shared<QByteArray const>(std::move(uncompressed)));
+}
@@ -0,0 +1,95 @@
+/*********
+*
+* In the name of the Father, and of the Son, and of the Holy Spirit.
+*
+* This file is part of BibleTime's source code, https://bibletime.info/
+*
+* Copyright 1999-2021 by the BibleTime developers.
+* The BibleTime source code is licensed under the GNU General Public License
+* version 2.0.
+*
+**********/
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QtGlobal>
+
+
+namespace sword {
+class SWModule;
+class VerseKey;
+} // namespace sword
+
+/**
+  \brief Reads raw entries of compressed verse based modules without Sword.
+
+  Supports the zText, zCom, zText4 and zCom4 drivers with ZIP compression.
+  The index and data files are memory-mapped. Decompressed blocks are kept in
+  a cache shared by all readers, whose size is limited by a memory budget.
+  This way, alternating between books or modules does not decompress the same
+  blocks over and over again, as the single block cache of Sword does.
+
+  A reader does not change after construction and may be used by several
+  threads concurrently.
+*/
+class BtZVerseReader {
+
+public: // methods:
+
+    BtZVerseReader(BtZVerseReader &&) = delete;
+    BtZVerseReader(BtZVerseReader const &) = delete;
+    BtZVerseReader & operator=(BtZVerseReader &&) = delete;
+    BtZVerseReader & operator=(BtZVerseReader const &) = delete;
+
+    ~BtZVerseReader();
+
+    /**
+      \returns a reader for the given module or nullptr if the module is not
+               supported, e.g. because it is encrypted or its data files can
+               not be mapped.
+    */
+    static std::unique_ptr<BtZVerseReader> create(sword::SWModule & module);
+
+    /**
+      \brief Reads the raw entry of a verse like sword::SWModule::getRawEntry()
+             does for modules without raw filters.
+      \param[in] key The verse in the versification of the module.
+      \returns the entry or std::nullopt if it could not be read.
+    */
+    std::optional<QByteArray> rawEntry(sword::VerseKey const & key) const;
+
+private: // types:
+
+    struct Testament {
+        QFile blockIndex;
+        QFile verseIndex;
+        QFile text;
+        uchar const * blockIndexData = nullptr;
+        uchar const * verseIndexData = nullptr;
+        uchar const * textData = nullptr;
+    };
+
+private: // methods:
+
+    BtZVerseReader(QString const & path, char blockType, bool wideSizes);
+
+    static bool mapTestament(Testament & testament,
+                             QString const & path,
+                             char const * testamentName,
+                             char blockType);
+
+    std::shared_ptr<QByteArray const> block(int testament,
+                                            quint32 blockNumber) const;
+
+private: // fields:
+
+    quint64 const m_id;
+    bool const m_wideSizes;
+    Testament m_testaments[2];
+
+};
@@ -13,7 +13,13 @@
 #include "cswordbookmoduleinfo.h"
 
 #include <QByteArray>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QIODevice>
 #include "../../util/btassert.h"
+#include "../../util/directory.h"
 #include "../keys/cswordtreekey.h"
 
 // Sword includes:
@@ -34,33 +40,63 @@
 #pragma GCC diagnostic pop
 
 
+// Change it once the format changed to make all systems rebuild their caches
+#define CACHE_FORMAT "2"
+
 CSwordBookModuleInfo::CSwordBookModuleInfo(sword::SWModule & module,
                                            CSwordBackend & backend)
     : CSwordModuleInfo(module, backend, CSwordModuleInfo::GenericBook)
-    , m_depth(
-        [this]{
-            if (auto * const key = tree()) {
-                key->root();
-                int maxDepth = 0;
-                for (int depth = 0;;) {
-                    do {
-                        while (key->firstChild()) {
-                            ++depth;
-                        }
-                    } while (key->nextSibling());
-                    if (depth > maxDepth)
-                        maxDepth = depth;
-                    do {
-                        if (!key->parent())
-                            return maxDepth;
-                        --depth;
-                    } while (!key->nextSibling());
-                }
-            }
-            return -1;
-        }())
 {}
 
+BtBookTreeIndex const & CSwordBookModuleInfo::treeIndex() const {
+    namespace DU = util::directory;
+
+    if (m_treeIndex)
+        return *m_treeIndex;
+
+    auto const & key = *tree();
+    auto const size = BtBookTreeIndex::indexFileSize(key);
+    // Works with the same name might be installed to different places:
+    QFile cacheFile(
+            QStringLiteral("%1/%2-%3.booktree")
+            .arg(DU::getUserCacheDir().absolutePath(),
+                 name(),
+                 QString::fromLatin1(
+                     QCryptographicHash::hash(
+                         config(CSwordModuleInfo::AbsoluteDataPath).toUtf8(),
+                         QCryptographicHash::Md5).toHex())));
+
+    if (cacheFile.open(QIODevice::ReadOnly)) {
+        QDataStream s(&cacheFile);
+        QString moduleVersion, cacheVersion, dataStreamVersion;
+        s >> moduleVersion >> cacheVersion >> dataStreamVersion;
+        if (moduleVersion == config(CSwordModuleInfo::ModuleVersion)
+            && cacheVersion == QStringLiteral(CACHE_FORMAT)
+            && dataStreamVersion == QString::number(s.version()))
+            m_treeIndex = BtBookTreeIndex::load(s, size);
+        cacheFile.close();
+        if (m_treeIndex)
+            return *m_treeIndex;
+    }
+
+    m_treeIndex = std::make_unique<BtBookTreeIndex const>(key, isUnicode());
+
+    if (cacheFile.open(QIODevice::WriteOnly)) {
+        QDataStream s(&cacheFile);
+        s << config(CSwordModuleInfo::ModuleVersion)
+          << QStringLiteral(CACHE_FORMAT)
+          << QString::number(s.version());
+        m_treeIndex->save(s);
+        cacheFile.close();
+    }
+    return *m_treeIndex;
+}
+
+void CSwordBookModuleInfo::setSwordModule(sword::SWModule & module) {
+    CSwordModuleInfo::setSwordModule(module);
+    m_treeIndex.reset();
+}
+
 sword::TreeKeyIdx * CSwordBookModuleInfo::tree() const {
     auto * const currentKey = swordModule().getKey();
     BT_ASSERT(dynamic_cast<sword::TreeKeyIdx *>(currentKey));
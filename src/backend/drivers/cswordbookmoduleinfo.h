@@ -14,8 +14,10 @@
 
 #include "cswordmoduleinfo.h"
 
+#include <memory>
 #include <QObject>
 #include <QString>
+#include "btbooktreeindex.h"
 
 
 class CSwordBackend;
@@ -38,7 +40,15 @@ public: // Methods:
     CSwordBookModuleInfo(sword::SWModule & module, CSwordBackend & usedBackend);
 
     /** \returns the maximal depth of sections and subsections. */
-    int depth() const noexcept { return m_depth; }
+    int depth() const { return treeIndex().depth(); }
+
+    /**
+      \brief The structure of the tree of this book.
+
+      The structure is read from the cache or walked when first needed, and not
+      when the module is loaded, because walking large books takes a while.
+    */
+    BtBookTreeIndex const & treeIndex() const;
 
     /**
       \returns A treekey filled with the structure of this module. Don't delete
@@ -48,8 +58,10 @@ public: // Methods:
 
     CSwordKey * createKey() const final override;
 
+    void setSwordModule(sword::SWModule & module) final override;
+
 private: // Fields:
 
-    int const m_depth;
+    mutable std::unique_ptr<BtBookTreeIndex const> m_treeIndex;
 
 };
@@ -12,6 +12,7 @@
 
 #include "cswordlexiconmoduleinfo.h"
 
+#include <QByteArray>
 #include <QChar>
 #include <QDataStream>
 #include <QDebug>
@@ -48,15 +49,24 @@
 CSwordLexiconModuleInfo::CSwordLexiconModuleInfo(sword::SWModule & module,
                                                  CSwordBackend & backend)
         : CSwordModuleInfo(module, backend, Lexicon)
-{
+{}
+
+void CSwordLexiconModuleInfo::detectStrongsKeys() const {
+    if (m_strongsKeysDetected)
+        return;
+    m_strongsKeysDetected = true;
+
     /**
       See if module keys are consistent with Strong's references
       and determine if keys start with "G" or "H" and the number
       of digits in the keys.
     */
+    auto & module = swordModule();
+    QByteArray const previousKey(module.getKeyText());
     module.setPosition(sword::TOP);
     module.increment();
     QString key = QString::fromUtf8(module.getKeyText());
+    module.getKey()->setText(previousKey.constData());
     QRegularExpression rx1(QStringLiteral("^[GH][0-9]+$"));
     if (rx1.match(key).hasMatch()) {
         m_hasStrongsKeys = true;
@@ -163,10 +173,12 @@ bool CSwordLexiconModuleInfo::snap() const
 { return swordModule().getRawEntry(); }
 
 bool CSwordLexiconModuleInfo:: hasStrongsKeys() const {
+    detectStrongsKeys();
     return m_hasStrongsKeys;
 }
 
 QString CSwordLexiconModuleInfo::normalizeStrongsKey(const QString &key) const {
+    detectStrongsKeys();
     if (auto const match =
                 QRegularExpression(QStringLiteral("^([GH]?)0*([0-9]+?)$"))
                     .match(key);
@@ -58,11 +58,21 @@ class CSwordLexiconModuleInfo final: public CSwordModuleInfo {
 
         CSwordKey * createKey() const final override;
 
+    private: // methods:
+
+        void detectStrongsKeys() const;
+
     private: // fields:
 
-        bool m_hasStrongsKeys = false;
-        bool m_hasLeadingStrongsLetter = false;
-        int m_strongsDigitsLength = 0;
+        /**
+          Whether the format of the keys has been detected. This is done on
+          first use, because it reads from the module, which is not needed
+          e.g. for the works listed in the bookshelf wizard.
+        */
+        mutable bool m_strongsKeysDetected = false;
+        mutable bool m_hasStrongsKeys = false;
+        mutable bool m_hasLeadingStrongsLetter = false;
+        mutable int m_strongsDigitsLength = 0;
 
         /**
           This is the list which caches the entres of the module.
@@ -35,6 +35,7 @@
 #include "../keys/cswordkey.h"
 #include "../managers/cswordbackend.h"
 #include "../cswordmodulesearch.h"
+#include "btzversereader.h"
 #include "cswordbiblemoduleinfo.h"
 #include "cswordlexiconmoduleinfo.h"
 
@@ -183,7 +184,7 @@ CSwordModuleInfo::FilterOption const CSwordModuleInfo::morphSegmentation{
 CSwordModuleInfo::CSwordModuleInfo(sword::SWModule & module,
                                    CSwordBackend & backend,
                                    ModuleType type)
-    : m_swordModule(module)
+    : m_swordModule(&module)
     , m_backend(backend)
     , m_type(type)
     , m_cancelIndexing(false)
@@ -221,6 +222,26 @@ CSwordModuleInfo::CSwordModuleInfo(sword::SWModule & module,
     }
 }
 
+CSwordModuleInfo::~CSwordModuleInfo() = default;
+
+void CSwordModuleInfo::setSwordModule(sword::SWModule & module) {
+    std::lock_guard const guard(m_zVerseReaderMutex);
+    m_swordModule = &module;
+    m_zVerseReader.reset();
+    m_zVerseReaderCreated = false;
+}
+
+BtZVerseReader const * CSwordModuleInfo::zVerseReader() const {
+    if (m_type != Bible && m_type != Commentary)
+        return nullptr;
+    std::lock_guard const guard(m_zVerseReaderMutex);
+    if (!m_zVerseReaderCreated) {
+        m_zVerseReader = BtZVerseReader::create(*m_swordModule);
+        m_zVerseReaderCreated = true;
+    }
+    return m_zVerseReader.get();
+}
+
 bool CSwordModuleInfo::unlock(const QString & unlockKey) {
     if (!isEncrypted())
         return false;
@@ -234,7 +255,7 @@ bool CSwordModuleInfo::unlock(const QString & unlockKey) {
        backend->setCipherKey() does not work correctly for modules from which
        data was already fetched. Therefore we have to reload the modules in
        bibletime.cpp */
-    m_backend.raw().setCipherKey(m_swordModule.getName(),
+    m_backend.raw().setCipherKey(m_swordModule->getName(),
                                  unlockKey.toUtf8().constData());
 
     /// \todo write to Sword config as well
@@ -269,11 +290,11 @@ bool CSwordModuleInfo::isEncrypted() const {
 }
 
 bool CSwordModuleInfo::unlockKeyIsValid() const {
-    sword::SWKey * const key = m_swordModule.getKey();
+    sword::SWKey * const key = m_swordModule->getKey();
     sword::VerseKey * const vk = dynamic_cast<sword::VerseKey *>(key);
     if (vk)
         vk->setIntros(false);
-    m_swordModule.setPosition(sword::TOP);
+    m_swordModule->setPosition(sword::TOP);
 
     /* This needs to use ::fromLatin1 because if the text is still locked, a lot
        of garbage will show up. It will also work with properly decrypted
@@ -281,8 +302,8 @@ bool CSwordModuleInfo::unlockKeyIsValid() const {
        and therefore contain no control (nonprintable) characters, which are all
        <127. */
     const QString test(isUnicode()
-                       ? QString::fromUtf8(m_swordModule.getRawEntry())
-                       : QString::fromLatin1(m_swordModule.getRawEntry()));
+                       ? QString::fromUtf8(m_swordModule->getRawEntry())
+                       : QString::fromLatin1(m_swordModule->getRawEntry()));
 
     if (test.isEmpty())
         return false;
@@ -294,7 +315,7 @@ bool CSwordModuleInfo::unlockKeyIsValid() const {
 }
 
 QString CSwordModuleInfo::getUnlockInfo() {
-    return m_swordModule.getConfigEntry("UnlockInfo");
+    return m_swordModule->getConfigEntry("UnlockInfo");
 }
 
 QString CSwordModuleInfo::getGlobalBaseIndexLocation() {
@@ -369,6 +390,9 @@ void CSwordModuleInfo::buildIndex() {
                 { m_cancelIndexing.store(false, std::memory_order_relaxed); });
 #define CANCEL_INDEXING (m_cancelIndexing.load(std::memory_order_relaxed))
 
+    // Restore the options of the rendering once indexing is done:
+    CSwordBackend::FilterOptionsScope const filterOptionsScope(m_backend);
+
     try {
         // Without this we don't get strongs, lemmas, etc.
         m_backend.setFilterOptions(btConfig().getFilterOptions());
@@ -414,10 +438,10 @@ void CSwordModuleInfo::buildIndex() {
         }
         else
         {
-            m_swordModule.setPosition(sword::TOP);
-            verseLowIndex = m_swordModule.getIndex();
-            m_swordModule.setPosition(sword::BOTTOM);
-            verseHighIndex = m_swordModule.getIndex();
+            m_swordModule->setPosition(sword::TOP);
+            verseLowIndex = m_swordModule->getIndex();
+            m_swordModule->setPosition(sword::BOTTOM);
+            verseHighIndex = m_swordModule->getIndex();
         }
 
         // verseLowIndex is not 0 in all cases (i.e. NT-only modules)
@@ -433,7 +457,7 @@ void CSwordModuleInfo::buildIndex() {
 
         Q_EMIT indexingProgress(0);
 
-        sword::SWKey * const key = m_swordModule.getKey();
+        sword::SWKey * const key = m_swordModule->getKey();
         sword::VerseKey * const vk = dynamic_cast<sword::VerseKey *>(key);
 
         if (vk) {
@@ -449,7 +473,7 @@ void CSwordModuleInfo::buildIndex() {
 
         // we start with the first module entry, key is automatically updated
         // because key is a pointer to the modules key
-        m_swordModule.setSkipConsecutiveLinks(true);
+        m_swordModule->setSkipConsecutiveLinks(true);
 
         std::unique_ptr<wchar_t[]> sPwcharBuffer(
                 new wchar_t[BT_MAX_LUCENE_FIELD_LENGTH  + 1]);
@@ -459,11 +483,11 @@ void CSwordModuleInfo::buildIndex() {
         if(bm && vk) // Implied that vk could be null due to cast above
             vk->setIndex(bm->lowerBound().index());
         else
-            m_swordModule.setPosition(sword::TOP);
+            m_swordModule->setPosition(sword::TOP);
 
         bool importantFilterOption = hasImportantFilterOption();
 
-        while (!(m_swordModule.popError()) && !CANCEL_INDEXING) {
+        while (!(m_swordModule->popError()) && !CANCEL_INDEXING) {
 
             /* Also index Chapter 0 and Verse 0, because they might have
                information in the entry attributes. We used to just put their
@@ -485,7 +509,7 @@ void CSwordModuleInfo::buildIndex() {
             if (importantFilterOption) {
                 // Index text including strongs, morph, footnotes, and headings.
                 setImportantFilterOptions(true);
-                textBuffer.append(m_swordModule.stripText());
+                textBuffer.append(m_swordModule->stripText());
                 lucene_utf8towcs(wcharBuffer,
                                  static_cast<const char *>(textBuffer),
                                  BT_MAX_LUCENE_FIELD_LENGTH);
@@ -498,7 +522,7 @@ void CSwordModuleInfo::buildIndex() {
 
             // Index text without strongs, morph, footnotes, and headings.
             setImportantFilterOptions(false);
-            textBuffer.append(m_swordModule.stripText());
+            textBuffer.append(m_swordModule->stripText());
             lucene_utf8towcs(wcharBuffer,
                              static_cast<const char *>(textBuffer),
                              BT_MAX_LUCENE_FIELD_LENGTH);
@@ -508,7 +532,7 @@ void CSwordModuleInfo::buildIndex() {
                                                    | lucene::document::Field::INDEX_TOKENIZED)));
             textBuffer.clear();
 
-            for (auto & vp : m_swordModule.getEntryAttributes()["Footnote"]) {
+            for (auto & vp : m_swordModule->getEntryAttributes()["Footnote"]) {
                 lucene_utf8towcs(wcharBuffer, vp.second["body"], BT_MAX_LUCENE_FIELD_LENGTH);
                 doc->add(*(new lucene::document::Field(static_cast<const TCHAR *>(_T("footnote")),
                                                        static_cast<const TCHAR *>(wcharBuffer),
@@ -518,7 +542,7 @@ void CSwordModuleInfo::buildIndex() {
 
             // Headings
             for (auto & vp
-                 : m_swordModule.getEntryAttributes()["Heading"]["Preverse"])
+                 : m_swordModule->getEntryAttributes()["Heading"]["Preverse"])
             {
                 lucene_utf8towcs(wcharBuffer, vp.second, BT_MAX_LUCENE_FIELD_LENGTH);
                 doc->add(*(new lucene::document::Field(static_cast<const TCHAR *>(_T("heading")),
@@ -528,7 +552,7 @@ void CSwordModuleInfo::buildIndex() {
             }
 
             // Strongs/Morphs
-            for (auto const & vp : m_swordModule.getEntryAttributes()["Word"]) {
+            for (auto const & vp : m_swordModule->getEntryAttributes()["Word"]) {
                 auto const & attrs = vp.second;
                 auto const partCountIter(attrs.find("PartCount"));
                 int partCount = (partCountIter != attrs.end())
@@ -566,7 +590,7 @@ void CSwordModuleInfo::buildIndex() {
             if (m_type == CSwordModuleInfo::Lexicon) {
                 verseIndex++;
             } else {
-                verseIndex = m_swordModule.getIndex();
+                verseIndex = m_swordModule->getIndex();
             }
 
             if (verseIndex % 200 == 0) {
@@ -580,7 +604,7 @@ void CSwordModuleInfo::buildIndex() {
                 }
             }
 
-            m_swordModule.increment();
+            m_swordModule->increment();
         } // while (!(m_module.Error()) && !CANCEL_INDEXING)
 
         if (!CANCEL_INDEXING)
@@ -637,7 +661,7 @@ CSwordModuleInfo::searchIndexed(QString const & searchedText,
     BT_ASSERT(wcharBuffer);
 
     // work around Swords thread insafety for Bibles and Commentaries
-    m_swordModule.setKey(createKey()->asSwordKey());
+    m_swordModule->setKey(createKey()->asSwordKey());
 
     // do not use any stop words
     lucene::analysis::standard::StandardAnalyzer analyzer(stop_words);
@@ -653,7 +677,7 @@ CSwordModuleInfo::searchIndexed(QString const & searchedText,
     const bool useScope = (scope.getCount() > 0);
 
     lucene::document::Document * doc = nullptr;
-    std::unique_ptr<sword::SWKey> swKey(m_swordModule.createKey());
+    std::unique_ptr<sword::SWKey> swKey(m_swordModule->createKey());
 
     sword::VerseKey * const vk = dynamic_cast<sword::VerseKey *>(swKey.get());
     if (vk)
@@ -701,7 +725,7 @@ QString CSwordModuleInfo::config(const CSwordModuleInfo::ConfigEntry entry) cons
 
         case CipherKey: {
             if (btConfig().getModuleEncryptionKey(m_cachedName).isNull()) {
-                return QString(m_swordModule.getConfigEntry("CipherKey")); // Fallback
+                return QString(m_swordModule->getConfigEntry("CipherKey")); // Fallback
             } else {
                 return btConfig().getModuleEncryptionKey(m_cachedName);
             }
@@ -818,10 +842,10 @@ QString CSwordModuleInfo::config(const CSwordModuleInfo::ConfigEntry entry) cons
 
 bool CSwordModuleInfo::has(const CSwordModuleInfo::Feature feature) const {
     switch (feature) {
-        case GreekDef: return m_swordModule.getConfig().has("Feature", "GreekDef");
-        case HebrewDef: return m_swordModule.getConfig().has("Feature", "HebrewDef");
-        case GreekParse: return m_swordModule.getConfig().has("Feature", "GreekParse");
-        case HebrewParse: return m_swordModule.getConfig().has("Feature", "HebrewParse");
+        case GreekDef: return m_swordModule->getConfig().has("Feature", "GreekDef");
+        case HebrewDef: return m_swordModule->getConfig().has("Feature", "HebrewDef");
+        case GreekParse: return m_swordModule->getConfig().has("Feature", "GreekParse");
+        case HebrewParse: return m_swordModule->getConfig().has("Feature", "HebrewParse");
     }
     return false;
 }
@@ -838,7 +862,7 @@ bool CSwordModuleInfo::has(CSwordModuleInfo::FilterOption const & option) const
         originalOptionName
     };
     for (auto [it, end] =
-                m_swordModule.getConfig().equal_range("GlobalOptionFilter");
+                m_swordModule->getConfig().equal_range("GlobalOptionFilter");
          it != end;
          ++it)
     {
@@ -861,21 +885,21 @@ char const * CSwordModuleInfo::textDirectionAsHtml() const
 { return textDirection() == RightToLeft ? "rtl" : "ltr"; }
 
 void CSwordModuleInfo::write(CSwordKey * key, const QString & newText) {
-    m_swordModule.setKey(key->key().toUtf8().constData());
+    m_swordModule->setKey(key->key().toUtf8().constData());
 
     /* Don't store a pointer to the const char* value somewhere because QCString
       doesn't keep the value of it. */
-    m_swordModule.setEntry(isUnicode()
+    m_swordModule->setEntry(isUnicode()
                       ? newText.toUtf8().constData()
                       : newText.toLocal8Bit().constData());
 }
 
 void CSwordModuleInfo::deleteEntry(CSwordKey * const key) {
     BT_ASSERT(key);
-    m_swordModule.setKey(isUnicode()
+    m_swordModule->setKey(isUnicode()
                     ? key->key().toUtf8().constData()
                     : key->key().toLocal8Bit().constData());
-    m_swordModule.deleteEntry();
+    m_swordModule->deleteEntry();
 }
 
 QString CSwordModuleInfo::aboutText() const {
@@ -891,7 +915,7 @@ QString CSwordModuleInfo::aboutText() const {
                  : tr("unknown"));
 
     {
-        const QString sourceType(m_swordModule.getConfigEntry("SourceType"));
+        const QString sourceType(m_swordModule->getConfigEntry("SourceType"));
         text += row
                 .arg(tr("Markup"))
                 .arg(!sourceType.isEmpty()
@@ -907,11 +931,11 @@ QString CSwordModuleInfo::aboutText() const {
             .arg(tr("Language"))
             .arg(m_cachedLanguage->translatedName().toHtmlEscaped());
 
-    if (char const * const e = m_swordModule.getConfigEntry("Category"))
+    if (char const * const e = m_swordModule->getConfigEntry("Category"))
         text += row.arg(tr("Category"))
                    .arg(QString{e}.toHtmlEscaped());
 
-    if (char const * const e = m_swordModule.getConfigEntry("LCSH"))
+    if (char const * const e = m_swordModule->getConfigEntry("LCSH"))
         text += row.arg(tr("LCSH"))
                    .arg(QString{e}.toHtmlEscaped());
 
@@ -923,7 +947,7 @@ QString CSwordModuleInfo::aboutText() const {
         text += row
                 .arg(tr("Unlock key"))
                 .arg(config(CSwordModuleInfo::CipherKey).toHtmlEscaped());
-        if (char const * const e = m_swordModule.getConfigEntry("UnlockInfo"))
+        if (char const * const e = m_swordModule->getConfigEntry("UnlockInfo"))
             text += row.arg(tr("Unlock info")).arg(QString(e).toHtmlEscaped());
     }
 
@@ -993,7 +1017,7 @@ QString CSwordModuleInfo::aboutText() const {
 }
 
 bool CSwordModuleInfo::isUnicode() const noexcept
-{ return m_swordModule.isUnicode(); }
+{ return m_swordModule->isUnicode(); }
 
 QIcon const & CSwordModuleInfo::moduleIcon(const CSwordModuleInfo & module) {
     CSwordModuleInfo::Category const cat(module.m_cachedCategory);
@@ -1077,8 +1101,8 @@ QString CSwordModuleInfo::categoryName(const CSwordModuleInfo::Category & catego
 
 QString CSwordModuleInfo::getSimpleConfigEntry(const QString & name) const {
     QString ret = isUnicode()
-                  ? QString::fromUtf8(m_swordModule.getConfigEntry(name.toUtf8().constData()))
-                  : QString::fromLatin1(m_swordModule.getConfigEntry(name.toUtf8().constData()));
+                  ? QString::fromUtf8(m_swordModule->getConfigEntry(name.toUtf8().constData()))
+                  : QString::fromLatin1(m_swordModule->getConfigEntry(name.toUtf8().constData()));
 
     return ret.isEmpty() ? QString() : ret;
 }
@@ -1092,10 +1116,10 @@ QString CSwordModuleInfo::getFormattedConfigEntry(const QString & name) const {
         sword::SWBuf RTF_Buffer;
         if (i < 0) {
             RTF_Buffer =
-                    m_swordModule.getConfigEntry(name.toUtf8().constData());
+                    m_swordModule->getConfigEntry(name.toUtf8().constData());
         } else {
             RTF_Buffer =
-                    m_swordModule.getConfigEntry(
+                    m_swordModule->getConfigEntry(
                         QStringLiteral("%1_%2")
                         .arg(name, localeNames[i])
                         .toUtf8().constData());
@@ -16,6 +16,7 @@
 
 #include <atomic>
 #include <memory>
+#include <mutex>
 #include <QIcon>
 #include <QMetaType>
 #include <QString>
@@ -29,6 +30,7 @@
 extern size_t lucene_utf8towcs(wchar_t *, const char *,  size_t maxslen);
 extern size_t lucene_wcstoutf8 (char *,  const wchar_t *, size_t maxslen);
 
+class BtZVerseReader;
 class CSwordBackend;
 class CSwordKey;
 namespace sword {
@@ -162,6 +164,8 @@ public: // methods:
     CSwordModuleInfo & operator=(CSwordModuleInfo &&) = delete;
     CSwordModuleInfo & operator=(CSwordModuleInfo const &) = delete;
 
+    ~CSwordModuleInfo() override;
+
     /**
     * Returns the base directory for search indices
     */
@@ -186,7 +190,22 @@ public: // methods:
     /**
     * Returns the module object so all objects can access the original Sword module.
     */
-    sword::SWModule & swordModule() const { return m_swordModule; }
+    sword::SWModule & swordModule() const { return *m_swordModule; }
+
+    /**
+      \brief Moves this work over to the given module object of the same work.
+      \note Used by CSwordBackend::reloadModules() only.
+      \pre The configuration of the given module is the same as the one of the
+           current module.
+      \note Drops the data cached from the files of the previous module object.
+    */
+    virtual void setSwordModule(sword::SWModule & module);
+
+    /**
+      \returns the reader for raw entries of this module which bypasses Sword
+               or nullptr if the module is not supported by BtZVerseReader.
+    */
+    BtZVerseReader const * zVerseReader() const;
 
     /**
     * Sets the unlock key of the modules and writes the key into the config file.
@@ -412,7 +431,7 @@ Q_SIGNALS:
 
 private: // fields:
 
-    sword::SWModule & m_swordModule;
+    sword::SWModule * m_swordModule;
     CSwordBackend & m_backend;
     ModuleType const m_type;
     bool m_hidden;
@@ -425,6 +444,10 @@ private: // fields:
     std::shared_ptr<Language const> const m_cachedGlossaryTargetLanguage;
     bool const m_cachedHasVersion;
 
+    mutable std::mutex m_zVerseReaderMutex;
+    mutable bool m_zVerseReaderCreated = false;
+    mutable std::unique_ptr<BtZVerseReader const> m_zVerseReader;
+
 };
 
 Q_DECLARE_METATYPE(CSwordModuleInfo::Category)
@@ -0,0 +1,80 @@
+/*********
+*
+* In the name of the Father, and of the Son, and of the Holy Spirit.
+*
+* This file is part of BibleTime's source code, https://bibletime.info/
+*
+* Copyright 1999-2021 by the BibleTime developers.
+* The BibleTime source code is licensed under the GNU General Public License
+* version 2.0.
+*
+**********/
+
+#include "btv11nmap.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include "../../util/btassert.h"
+
+// Sword includes:
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wextra-semi"
+#pragma GCC diagnostic ignored "-Wsuggest-override"
+#pragma GCC diagnostic ignored "-Wzero-as-null-pointer-constant"
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wsuggest-destructor-override"
+#endif
+#include <swkey.h>
+#include <versekey.h>
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+#pragma GCC diagnostic pop
+
+
+BtV11nMap::BtV11nMap(char const * const from, char const * const to) {
+    sword::VerseKey source;
+    source.setVersificationSystem(from);
+    source.setIntros(true);
+    source.setPosition(sword::BOTTOM);
+    auto const maxIndex = source.getIndex();
+    m_map.reserve(static_cast<std::size_t>(maxIndex) + 1u);
+
+    sword::VerseKey target;
+    target.setVersificationSystem(to);
+    target.setIntros(true);
+    for (long index = 0; index <= maxIndex; ++index) {
+        source.setIndex(index);
+        if (source.popError()) {
+            m_map.push_back(-1);
+            continue;
+        }
+        target.clearBounds();
+        target.positionFrom(source);
+        if (target.popError() || target.isBoundSet()) {
+            m_map.push_back(-1);
+        } else {
+            m_map.push_back(static_cast<qint32>(target.getIndex()));
+        }
+    }
+}
+
+BtV11nMap const & BtV11nMap::instance(char const * const from,
+                                      char const * const to)
+{
+    BT_ASSERT(from);
+    BT_ASSERT(to);
+    static std::mutex mutex;
+    static std::map<std::pair<std::string, std::string>,
+                    std::unique_ptr<BtV11nMap const>> maps;
+
+    std::lock_guard const guard(mutex);
+    auto & map = maps[std::make_pair(std::string(from), std::string(to))];
+    if (!map)
+        map.reset(new BtV11nMap(from, to));
+    return *map;
+}
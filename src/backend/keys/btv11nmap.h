@@ -0,0 +1,65 @@
+/*********
+*
+* In the name of the Father, and of the Son, and of the Holy Spirit.
+*
+* This file is part of BibleTime's source code, https://bibletime.info/
+*
+* Copyright 1999-2021 by the BibleTime developers.
+* The BibleTime source code is licensed under the GNU General Public License
+* version 2.0.
+*
+**********/
+
+#pragma once
+
+#include <cstddef>
+#include <QtGlobal>
+#include <vector>
+
+
+/**
+  \brief Maps verse indexes from one versification system to another.
+
+  Sword maps a verse to another versification system by translating its book,
+  chapter and verse through the mapping tables of both systems every time. A
+  BtV11nMap does this once for every verse of the source versification system
+  and answers further requests with a lookup. The maps are built on first use
+  and shared by all users, including other threads.
+*/
+class BtV11nMap {
+
+public: // methods:
+
+    BtV11nMap(BtV11nMap &&) = delete;
+    BtV11nMap(BtV11nMap const &) = delete;
+    BtV11nMap & operator=(BtV11nMap &&) = delete;
+    BtV11nMap & operator=(BtV11nMap const &) = delete;
+
+    /**
+      \returns the shared map between the given versification systems.
+      \pre The versification systems differ.
+    */
+    static BtV11nMap const & instance(char const * from, char const * to);
+
+    /**
+      \param[in] index The index of a verse in the source versification.
+      \returns the index of the verse in the target versification or -1 if the
+               verse can not be mapped by a lookup. This is the case for verses
+               missing from the target versification or mapped to a range of
+               verses, which need to be mapped by Sword instead.
+    */
+    long map(long const index) const noexcept {
+        return (index >= 0 && static_cast<std::size_t>(index) < m_map.size())
+               ? m_map[static_cast<std::size_t>(index)]
+               : -1;
+    }
+
+private: // methods:
+
+    BtV11nMap(char const * from, char const * to);
+
+private: // fields:
+
+    std::vector<qint32> m_map;
+
+};
@@ -0,0 +1,72 @@
+/*********
+*
+* In the name of the Father, and of the Son, and of the Holy Spirit.
+*
+* This file is part of BibleTime's source code, https://bibletime.info/
+*
+* Copyright 1999-2021 by the BibleTime developers.
+* The BibleTime source code is licensed under the GNU General Public License
+* version 2.0.
+*
+**********/
+
+#include "btversificationtable.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "../../util/btassert.h"
+
+// Sword includes:
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wextra-semi"
+#pragma GCC diagnostic ignored "-Wsuggest-override"
+#pragma GCC diagnostic ignored "-Wzero-as-null-pointer-constant"
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wsuggest-destructor-override"
+#endif
+#include <swkey.h>
+#include <versekey.h>
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+#pragma GCC diagnostic pop
+
+
+BtVersificationTable::BtVersificationTable(char const * const versification) {
+    sword::VerseKey key;
+    key.setVersificationSystem(versification);
+    key.setIntros(true);
+    key.setPosition(sword::BOTTOM);
+    auto const maxIndex = key.getIndex();
+    m_verses.reserve(static_cast<std::size_t>(maxIndex) + 1u);
+    for (long index = 0; index <= maxIndex; ++index) {
+        key.setIndex(index);
+        if (key.popError()) {
+            m_verses.push_back(Verse{0, 0, 0u, 0u});
+        } else {
+            m_verses.push_back(
+                        Verse{key.getTestament(),
+                              key.getBook(),
+                              static_cast<quint16>(key.getChapter()),
+                              static_cast<quint16>(key.getVerse())});
+        }
+    }
+}
+
+BtVersificationTable const & BtVersificationTable::instance(
+        char const * const versification)
+{
+    BT_ASSERT(versification);
+    static std::mutex mutex;
+    static std::map<std::string, std::unique_ptr<BtVersificationTable const>>
+            tables;
+
+    std::lock_guard const guard(mutex);
+    auto & table = tables[versification];
+    if (!table)
+        table.reset(new BtVersificationTable(versification));
+    return *table;
+}
@@ -0,0 +1,69 @@
+/*********
+*
+* In the name of the Father, and of the Son, and of the Holy Spirit.
+*
+* This file is part of BibleTime's source code, https://bibletime.info/
+*
+* Copyright 1999-2021 by the BibleTime developers.
+* The BibleTime source code is licensed under the GNU General Public License
+* version 2.0.
+*
+**********/
+
+#pragma once
+
+#include <cstddef>
+#include <QtGlobal>
+#include <vector>
+
+
+/**
+  \brief The book, chapter and verse of every verse index of a versification.
+
+  Finding out the verse at an index with Sword requires constructing and
+  positioning a sword::VerseKey. The table answers this by a lookup instead,
+  which makes it cheap enough to be used for every row of a text model. The
+  tables are built on first use and shared by all users, including other
+  threads.
+*/
+class BtVersificationTable {
+
+public: // types:
+
+    struct Verse {
+        char testament; /**< 0 for the module heading */
+        char book; /**< Within the testament, 0 for the testament heading */
+        quint16 chapter; /**< 0 for the book heading */
+        quint16 verse; /**< 0 for the chapter heading */
+    };
+
+public: // methods:
+
+    BtVersificationTable(BtVersificationTable &&) = delete;
+    BtVersificationTable(BtVersificationTable const &) = delete;
+    BtVersificationTable & operator=(BtVersificationTable &&) = delete;
+    BtVersificationTable & operator=(BtVersificationTable const &) = delete;
+
+    /** \returns the shared table of the given versification system. */
+    static BtVersificationTable const & instance(char const * versification);
+
+    /**
+      \param[in] index The index of a verse like sword::VerseKey::getIndex().
+      \returns the verse at the index or a module heading if the index is out
+               of range.
+    */
+    Verse verse(long const index) const noexcept {
+        return (index >= 0 && static_cast<std::size_t>(index) < m_verses.size())
+               ? m_verses[static_cast<std::size_t>(index)]
+               : Verse{0, 0, 0u, 0u};
+    }
+
+private: // methods:
+
+    explicit BtVersificationTable(char const * versification);
+
+private: // fields:
+
+    std::vector<Verse> m_verses;
+
+};
@@ -12,10 +12,13 @@
 
 #include "cswordkey.h"
 
-#include <QRegExp>
+#include <QRegularExpression>
+#include <QRegularExpressionMatch>
+#include <QRegularExpressionMatchIterator>
 #include <QString>
 #include <string>
 #include "../../util/btassert.h"
+#include "../drivers/btzversereader.h"
 #include "../drivers/cswordmoduleinfo.h"
 
 // Sword includes:
@@ -37,6 +40,54 @@
 #pragma GCC diagnostic pop
 
 
+namespace {
+
+/**
+  \brief Links the Strong's numbers referred to as e.g. "GREEK for 0123" or
+         "HEBREW for 123" outside of tags in the given text to their entries.
+*/
+QString linkStrongsReferences(QString const & text) {
+    static QRegularExpression const rx(
+                QStringLiteral("(GREEK|HEBREW) for (0*([1-9]\\d*))\\b"));
+
+    QString r;
+    int copied = 0; // Characters of text already appended to r
+    int scanned = 0; // Characters of text already checked for tags
+    bool inTag = false;
+    for (auto it = rx.globalMatch(text); it.hasNext();) {
+        auto const match = it.next();
+        auto const start = match.capturedStart();
+        for (; scanned < start; ++scanned) {
+            if (text[scanned] == '<') {
+                inTag = true;
+            } else if (text[scanned] == '>') {
+                inTag = false;
+            }
+        }
+        if (inTag)
+            continue;
+
+        if (r.isNull())
+            r.reserve(text.size() + text.size() / 4);
+        auto const language = match.captured(1);
+        auto const numberStart = match.capturedStart(2);
+        auto const number = match.captured(2);
+        r.append(text.midRef(copied, numberStart - copied))
+         .append(QStringLiteral("<span lemma=\"%1%2\">"
+                                "<a href=\"strongs://%3/%2\">%4</a></span>")
+                     .arg(language.at(0), // "G" or "H"
+                          match.captured(3).rightJustified(5, '0'),
+                          language,
+                          number));
+        copied = numberStart + number.size();
+    }
+    if (r.isNull())
+        return text;
+    return r.append(text.midRef(copied));
+}
+
+} // anonymous namespace
+
 CSwordKey::~CSwordKey() noexcept = default;
 
 QString CSwordKey::normalizedKey() const { return key(); }
@@ -51,6 +102,8 @@ QString CSwordKey::rawText() {
     if (key().isNull())
         return QString();
 
+    if (auto const entry = nativeRawEntry())
+        return QString::fromUtf8(*entry);
     return QString::fromUtf8(m.getRawEntry());
 }
 
@@ -85,29 +138,8 @@ QString CSwordKey::renderedText(const CSwordKey::TextRenderType mode) {
         return QString();
 
     // This is yucky, but if we want strong lexicon refs we have to do it here.
-    if (m_module->type() == CSwordModuleInfo::Lexicon) {
-        const QString t(text);
-        QRegExp const rx(QStringLiteral("(GREEK|HEBREW) for 0*([1-9]\\d*)"));
-        int pos = 0;
-        while ((pos = rx.indexIn(t, pos)) != -1) {
-            auto language = rx.cap(1);
-            auto langcode = language.at(0); // "G" or "H"
-            auto number = rx.cap(2);
-            auto paddednumber = number.rightJustified(5, '0'); // Form 00123
-
-            text.replace(
-                QRegExp(QStringLiteral(
-                            "(>[^<>]+)" // Avoid replacing inside tags
-                            "\\b(0*%1)\\b") // And span around 0's
-                        .arg(std::move(number))),
-                QStringLiteral("\\1<span lemma=\"%1%2\">"
-                               "<a href=\"strongs://%3/%2\">\\2</a></span>")
-                    .arg(std::move(langcode),
-                         std::move(paddednumber),
-                         std::move(language)));
-            pos += rx.matchedLength();
-        }
-    }
+    if (m_module->type() == CSwordModuleInfo::Lexicon)
+        return linkStrongsReferences(text);
     return text;
 }
 
@@ -118,5 +150,20 @@ QString CSwordKey::strippedText() {
     auto & m = m_module->swordModule();
     m.getKey()->setText(std::string(rawKey()).c_str());
 
+    if (auto const entry = nativeRawEntry())
+        return QString::fromUtf8(m.stripText(entry->constData(),
+                                             entry->size()));
     return QString::fromUtf8(m.stripText());
 }
+
+std::optional<QByteArray> CSwordKey::nativeRawEntry() const {
+    auto const * const reader = m_module->zVerseReader();
+    if (!reader)
+        return std::nullopt;
+    auto const * const vk =
+            dynamic_cast<sword::VerseKey const *>(
+                m_module->swordModule().getKey());
+    if (!vk)
+        return std::nullopt;
+    return reader->rawEntry(*vk);
+}
@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <optional>
+#include <QByteArray>
 #include <QString>
 
 
@@ -107,6 +109,15 @@ protected: // methods:
     */
     virtual const char * rawKey() const = 0;
 
+private: // methods:
+
+    /**
+      \returns the raw entry at the current position of the key of the Sword
+               module as read by BtZVerseReader or std::nullopt if the module
+               is not supported by it.
+    */
+    std::optional<QByteArray> nativeRawEntry() const;
+
 protected: // fields:
 
     const CSwordModuleInfo * m_module;
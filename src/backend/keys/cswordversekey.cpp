@@ -17,6 +17,7 @@
 #include <string_view>
 #include "../../util/btassert.h"
 #include "../drivers/cswordbiblemoduleinfo.h"
+#include "btv11nmap.h"
 
 // Sword includes:
 #pragma GCC diagnostic push
@@ -82,12 +83,22 @@ void CSwordVerseKey::setModule(const CSwordModuleInfo *newModule) {
 
     if (strcmp(m_key.getVersificationSystem(), newVersification)) {
         /// Remap key position to new versification
-        sword::VerseKey oldKey(m_key);
-
-        m_key.setVersificationSystem(newVersification);
-
-        m_key.positionFrom(oldKey);
-        inVersification = !m_key.popError();
+        auto const mappedIndex =
+                m_key.isBoundSet()
+                ? -1
+                : BtV11nMap::instance(m_key.getVersificationSystem(),
+                                      newVersification).map(m_key.getIndex());
+        if (mappedIndex >= 0) {
+            m_key.setVersificationSystem(newVersification);
+            m_key.setIndex(mappedIndex);
+        } else {
+            sword::VerseKey oldKey(m_key);
+
+            m_key.setVersificationSystem(newVersification);
+
+            m_key.positionFrom(oldKey);
+            inVersification = !m_key.popError();
+        }
     }
 
     m_module = newModule;
@@ -107,6 +118,26 @@ void CSwordVerseKey::setModule(const CSwordModuleInfo *newModule) {
     m_valid = inVersification;
 }
 
+void CSwordVerseKey::setModuleAndIndex(CSwordModuleInfo const * newModule,
+                                       long index)
+{
+    BT_ASSERT(newModule);
+    BT_ASSERT(newModule->type() == CSwordModuleInfo::Bible ||
+             newModule->type() == CSwordModuleInfo::Commentary);
+
+    auto const * const bible =
+            static_cast<CSwordBibleModuleInfo const *>(newModule);
+    m_key.setVersificationSystem(
+                static_cast<sword::VerseKey *>(
+                    bible->swordModule().getKey())->getVersificationSystem());
+    m_key.clearBounds();
+    m_key.setIndex(index);
+    m_module = newModule;
+    m_valid = !m_key.popError();
+
+    emitAfterChanged();
+}
+
 CSwordVerseKey CSwordVerseKey::lowerBound() const
 { return {&m_key.getLowerBound(), module()}; }
 
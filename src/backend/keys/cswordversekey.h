@@ -145,6 +145,13 @@ class CSwordVerseKey final : public CSwordKey {
 
         void setModule(const CSwordModuleInfo *newModule) final override;
 
+        /**
+          \brief Sets the module and the verse at the given index in the
+                 versification of the module, without mapping the current
+                 verse to the new versification first.
+        */
+        void setModuleAndIndex(CSwordModuleInfo const * newModule, long index);
+
         CSwordVerseKey lowerBound() const;
         void setLowerBound(CSwordVerseKey const & bound);
 
@@ -15,10 +15,13 @@
 #include <QDebug>
 #include <QDir>
 #include <QFileInfo>
+#include <QHash>
+#include <QList>
 #include <QSet>
 #include <QString>
 #include <QTextCodec>
 #include <string_view>
+#include <utility>
 #include "../../util/btconnect.h"
 #include "../../util/directory.h"
 #include "../btglobal.h"
@@ -51,12 +54,59 @@
 #pragma GCC diagnostic pop
 
 
+namespace {
+
+struct FilterOptionField {
+    CSwordModuleInfo::FilterOption const & option;
+    int FilterOptions::* state;
+};
+
+FilterOptionField const filterOptionFields[] = {
+    {CSwordModuleInfo::footnotes,           &FilterOptions::footnotes},
+    {CSwordModuleInfo::strongNumbers,       &FilterOptions::strongNumbers},
+    {CSwordModuleInfo::headings,            &FilterOptions::headings},
+    {CSwordModuleInfo::morphTags,           &FilterOptions::morphTags},
+    {CSwordModuleInfo::lemmas,              &FilterOptions::lemmas},
+    {CSwordModuleInfo::hebrewPoints,        &FilterOptions::hebrewPoints},
+    {CSwordModuleInfo::hebrewCantillation,  &FilterOptions::hebrewCantillation},
+    {CSwordModuleInfo::greekAccents,        &FilterOptions::greekAccents},
+    {CSwordModuleInfo::redLetterWords,      &FilterOptions::redLetterWords},
+    {CSwordModuleInfo::textualVariants,     &FilterOptions::textualVariants},
+    {CSwordModuleInfo::morphSegmentation,   &FilterOptions::morphSegmentation},
+    // {CSwordModuleInfo::transliteration, &FilterOptions::transliteration},
+    {CSwordModuleInfo::scriptureReferences, &FilterOptions::scriptureReferences},
+};
+
+FilterOptions unappliedFilterOptions() {
+    FilterOptions r;
+    for (auto const & field : filterOptionFields)
+        r.*field.state = -1;
+    return r;
+}
+
+} // anonymous namespace
+
 CSwordBackend * CSwordBackend::m_instance = nullptr;
 
+CSwordBackend::FilterOptionsScope::FilterOptionsScope(CSwordBackend & backend)
+    : m_backend(backend)
+    , m_previousOptions(backend.filterOptions())
+{}
+
+CSwordBackend::FilterOptionsScope::FilterOptionsScope(
+        CSwordBackend & backend,
+        FilterOptions const & options)
+    : FilterOptionsScope(backend)
+{ backend.setFilterOptions(options); }
+
+CSwordBackend::FilterOptionsScope::~FilterOptionsScope()
+{ m_backend.setFilterOptions(m_previousOptions); }
+
 CSwordBackend::CSwordBackend()
-        : m_manager(nullptr, nullptr, false,
-                    new sword::EncodingFilterMgr(sword::ENC_UTF8), true)
+        : m_augmentHome(true)
+        , m_manager(createManager())
         , m_dataModel(BtBookshelfModel::newInstance())
+        , m_filterOptions(unappliedFilterOptions())
 {
     auto const clearCache =
             [this]() noexcept {
@@ -79,16 +129,28 @@ CSwordBackend::CSwordBackend()
 }
 
 CSwordBackend::CSwordBackend(const QString & path, const bool augmentHome)
-        : m_manager(!path.isEmpty() ? path.toLocal8Bit().constData() : nullptr,
-                    false, new sword::EncodingFilterMgr(sword::ENC_UTF8),
-                    false, augmentHome)
+        : m_path(path)
+        , m_augmentHome(augmentHome)
+        , m_manager(createManager())
         , m_dataModel(BtBookshelfModel::newInstance())
+        , m_filterOptions(unappliedFilterOptions())
 {}
 
 CSwordBackend::~CSwordBackend() {
     shutdownModules();
 }
 
+std::unique_ptr<CSwordBackend::Private> CSwordBackend::createManager() const {
+    if (!m_path.has_value())
+        return std::make_unique<Private>(
+                    nullptr, nullptr, false,
+                    new sword::EncodingFilterMgr(sword::ENC_UTF8), true);
+    return std::make_unique<Private>(
+                !m_path->isEmpty() ? m_path->toLocal8Bit().constData() : nullptr,
+                false, new sword::EncodingFilterMgr(sword::ENC_UTF8),
+                false, m_augmentHome);
+}
+
 CSwordModuleInfo * CSwordBackend::findFirstAvailableModule(CSwordModuleInfo::ModuleType type) {
 
     for (CSwordModuleInfo * const m : moduleList())
@@ -194,50 +256,12 @@ CSwordBackend::LoadError CSwordBackend::initModules() {
     shutdownModules(); // Remove previous modules
     m_dataModel->clear();
 
-    const LoadError ret = static_cast<LoadError>(m_manager.load());
+    const LoadError ret = static_cast<LoadError>(m_manager->load());
 
-    for (auto const & modulePair : m_manager.getModules()) {
+    for (auto const & modulePair : m_manager->getModules()) {
         sword::SWModule * const curMod = modulePair.second;
         BT_ASSERT(curMod);
-        std::unique_ptr<CSwordModuleInfo> newModule;
-
-        std::string_view const modType = curMod->getType();
-        using namespace std::literals;
-        if (modType == "Biblical Texts"sv) {
-            newModule = std::make_unique<CSwordBibleModuleInfo>(*curMod, *this);
-        } else if (modType == "Commentaries"sv) {
-            newModule = std::make_unique<CSwordCommentaryModuleInfo>(*curMod,
-                                                                     *this);
-        } else if (modType == "Lexicons / Dictionaries"sv) {
-            newModule = std::make_unique<CSwordLexiconModuleInfo>(*curMod,
-                                                                  *this);
-        } else if (modType == "Generic Books"sv) {
-            newModule = std::make_unique<CSwordBookModuleInfo>(*curMod, *this);
-        } else {
-            continue;
-        }
-
-        // Append the new modules to our list, but only if it's supported
-        // The constructor of CSwordModuleInfo prints a warning on stdout
-        if (!newModule->hasVersion()
-            || (newModule->minimumSwordVersion() <= sword::SWVersion::currentVersion))
-        {
-
-            /* There is currently a deficiency in sword 1.8.1 in that backend->setCipherKey() does
-             * not work correctly for modules from which data was already fetched. Therefore we have to
-             * reload the modules. The cipher key must be set before any read occurs on the module.
-             * Reading from the module can happen in subtle ways. The addModule below causes a read
-             * to determine if the locked or unlocked icon is used by the model.
-             */
-            if (newModule->isEncrypted()) {
-                auto const unlockKey(
-                        btConfig().getModuleEncryptionKey(newModule->name()));
-                if (!unlockKey.isNull())
-                    m_manager.setCipherKey(
-                                newModule->name().toUtf8().constData(),
-                                unlockKey.toUtf8().constData());
-            }
-
+        if (auto newModule = createModuleInfo(*curMod)) {
             /// \todo Refactor data model to use shared_ptr to contain works
             m_dataModel->addModule(newModule.get());
             newModule.release();
@@ -248,6 +272,47 @@ CSwordBackend::LoadError CSwordBackend::initModules() {
     return ret;
 }
 
+std::unique_ptr<CSwordModuleInfo> CSwordBackend::createModuleInfo(
+        sword::SWModule & module)
+{
+    std::unique_ptr<CSwordModuleInfo> newModule;
+
+    std::string_view const modType = module.getType();
+    using namespace std::literals;
+    if (modType == "Biblical Texts"sv) {
+        newModule = std::make_unique<CSwordBibleModuleInfo>(module, *this);
+    } else if (modType == "Commentaries"sv) {
+        newModule = std::make_unique<CSwordCommentaryModuleInfo>(module, *this);
+    } else if (modType == "Lexicons / Dictionaries"sv) {
+        newModule = std::make_unique<CSwordLexiconModuleInfo>(module, *this);
+    } else if (modType == "Generic Books"sv) {
+        newModule = std::make_unique<CSwordBookModuleInfo>(module, *this);
+    } else {
+        return nullptr;
+    }
+
+    // Only return the new module if it's supported
+    // The constructor of CSwordModuleInfo prints a warning on stdout
+    if (newModule->hasVersion()
+        && (newModule->minimumSwordVersion() > sword::SWVersion::currentVersion))
+        return nullptr;
+
+    /* There is currently a deficiency in sword 1.8.1 in that backend->setCipherKey() does
+     * not work correctly for modules from which data was already fetched. Therefore we have to
+     * reload the modules. The cipher key must be set before any read occurs on the module.
+     * Reading from the module can happen in subtle ways. Adding the module to the model causes
+     * a read to determine if the locked or unlocked icon is used by the model.
+     */
+    if (newModule->isEncrypted()) {
+        auto const unlockKey(
+                btConfig().getModuleEncryptionKey(newModule->name()));
+        if (!unlockKey.isNull())
+            m_manager->setCipherKey(newModule->name().toUtf8().constData(),
+                                    unlockKey.toUtf8().constData());
+    }
+    return newModule;
+}
+
 void CSwordBackend::Private::addRenderFilters(sword::SWModule * module,
                                               sword::ConfigEntMap & section)
 {
@@ -279,7 +344,7 @@ void CSwordBackend::Private::addRenderFilters(sword::SWModule * module,
 
 void CSwordBackend::shutdownModules() {
     m_dataModel->clear(true);
-    m_manager.shutdownModules();
+    m_manager->shutdownModules();
 }
 
 void CSwordBackend::Private::shutdownModules() {
@@ -301,22 +366,31 @@ void CSwordBackend::Private::shutdownModules() {
 
 void CSwordBackend::setOption(CSwordModuleInfo::FilterOption const & option,
                               const int state)
-{ m_manager.setGlobalOption(option.optionName, option.valueToString(state)); }
+{
+    if (state < 0)
+        return;
+    for (auto const & field : filterOptionFields) {
+        if (&field.option == &option) {
+            auto & appliedState = m_filterOptions.*field.state;
+            if (appliedState == state)
+                return;
+            appliedState = state;
+            break;
+        }
+    }
+    m_manager->setGlobalOption(option.optionName, option.valueToString(state));
+}
 
 void CSwordBackend::setFilterOptions(const FilterOptions & options) {
-    setOption(CSwordModuleInfo::footnotes,           options.footnotes);
-    setOption(CSwordModuleInfo::strongNumbers,       options.strongNumbers);
-    setOption(CSwordModuleInfo::headings,            options.headings);
-    setOption(CSwordModuleInfo::morphTags,           options.morphTags);
-    setOption(CSwordModuleInfo::lemmas,              options.lemmas);
-    setOption(CSwordModuleInfo::hebrewPoints,        options.hebrewPoints);
-    setOption(CSwordModuleInfo::hebrewCantillation,  options.hebrewCantillation);
-    setOption(CSwordModuleInfo::greekAccents,        options.greekAccents);
-    setOption(CSwordModuleInfo::redLetterWords,      options.redLetterWords);
-    setOption(CSwordModuleInfo::textualVariants,     options.textualVariants);
-    setOption(CSwordModuleInfo::morphSegmentation,   options.morphSegmentation);
-    // setOption(CSwordModuleInfo::transliteration,   options.transliteration);
-    setOption(CSwordModuleInfo::scriptureReferences, options.scriptureReferences);
+    for (auto const & field : filterOptionFields) {
+        auto const state = options.*field.state;
+        auto & appliedState = m_filterOptions.*field.state;
+        if (state < 0 || appliedState == state)
+            continue;
+        appliedState = state;
+        m_manager->setGlobalOption(field.option.optionName,
+                                  field.option.valueToString(state));
+    }
 }
 
 CSwordModuleInfo * CSwordBackend::findModuleByName(const QString & name) const {
@@ -357,24 +431,56 @@ void CSwordBackend::setBooknameLanguage(QString const & language) {
 }
 
 void CSwordBackend::reloadModules() {
-    shutdownModules();
-    m_manager.reloadConfig();
-    initModules();
-}
+    /* Sword can not add or remove single modules, hence all modules are loaded
+       by a new manager. Works whose configuration did not change are moved over
+       to the modules of the new manager, dropping only the data they cached
+       from the files of the old modules. The works are only added to or removed
+       from the model if they were installed, updated or removed. Encrypted
+       works are always recreated, since their unlock key may have changed. The
+       old manager is kept alive until the model no longer refers to any of its
+       modules: */
+    auto newManager(createManager());
+    newManager->load();
+
+    QHash<QString, sword::SWModule *> newModules;
+    for (auto const & modulePair : newManager->getModules())
+        newModules.insert(QString::fromUtf8(modulePair.second->getName()),
+                          modulePair.second);
+
+    QList<std::pair<CSwordModuleInfo *, sword::SWModule *>> keptModules;
+    BtConstModuleSet removedModules;
+    for (auto * const module : moduleList()) {
+        auto const it = newModules.find(module->name());
+        if (it != newModules.end()
+            && !module->isEncrypted()
+            && (module->swordModule().getConfig() == (*it)->getConfig()))
+        {
+            keptModules.append({module, *it});
+            newModules.erase(it);
+        } else {
+            removedModules.insert(module);
+        }
+    }
+    m_dataModel->removeModules(removedModules, true);
 
-void CSwordBackend::Private::reloadConfig() {
-    //delete Sword's config to make Sword reload it!
-
-    if (myconfig) { // force reload on config object because we may have changed the paths
-        delete myconfig;
-        config = myconfig = nullptr;
-        // we need to call findConfig to make sure that augPaths are reloaded
-        findConfig(&configType, &prefixPath, &configPath, &augPaths, &sysConfig);
-        // now re-read module configuration files
-        loadConfigDir(configPath);
-    } else if (config) {
-        config->load();
+    for (auto const & keptModule : keptModules)
+        keptModule.first->setSwordModule(*keptModule.second);
+    std::swap(m_manager, newManager);
+    newManager->shutdownModules();
+    newManager.reset();
+    m_filterOptions = unappliedFilterOptions(); // Unknown to the new manager
+
+    for (auto const & modulePair : m_manager->getModules()) {
+        sword::SWModule * const curMod = modulePair.second;
+        if (!newModules.contains(QString::fromUtf8(curMod->getName())))
+            continue;
+        if (auto newModule = createModuleInfo(*curMod)) {
+            m_dataModel->addModule(newModule.get());
+            newModule.release();
+        }
     }
+
+    Q_EMIT sigSwordSetupChanged();
 }
 
 // Return a list of used Sword dirs. Useful for the installer.
@@ -417,7 +523,7 @@ QStringList CSwordBackend::swordDirList() const {
 
         #else
         // /etc/sword.conf, /usr/local/etc/sword.conf
-        for (auto const & path : QString(m_manager.globalConfPath).split(':'))
+        for (auto const & path : QString(m_manager->globalConfPath).split(':'))
             if (auto conf = QFileInfo(path); conf.exists())
                 configs << std::move(conf);
         #endif
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <QObject>
 #include <QString>
 #include <QStringList>
@@ -69,11 +70,60 @@ public: // types:
         NoModules = 1
     };
 
+    /**
+      \brief Takes a snapshot of the applied filter options and restores it on
+             destruction.
+
+      This allows to temporarily render text with different filter options
+      without the following rendering having to re-apply its own options.
+    */
+    class FilterOptionsScope {
+
+    public: // methods:
+
+        explicit FilterOptionsScope(CSwordBackend & backend);
+
+        /** \brief Takes the snapshot and then applies the given options. */
+        FilterOptionsScope(CSwordBackend & backend,
+                           FilterOptions const & options);
+
+        FilterOptionsScope(FilterOptionsScope const &) = delete;
+        FilterOptionsScope & operator=(FilterOptionsScope const &) = delete;
+
+        ~FilterOptionsScope();
+
+    private: // fields:
+
+        CSwordBackend & m_backend;
+        FilterOptions const m_previousOptions;
+
+    };
+
 private: // types:
 
     using AvailableLanguagesCacheContainer =
             std::set<std::shared_ptr<Language const>>;
 
+    struct Private: public sword::SWMgr {
+
+    // Methods:
+
+        using sword::SWMgr::SWMgr;
+
+        void shutdownModules();
+        void addRenderFilters(sword::SWModule * module,
+                              sword::ConfigEntMap & section) override;
+
+    // Fields:
+
+        Filters::GbfToHtml   m_gbfFilter;
+        Filters::OsisToHtml  m_osisFilter;
+        Filters::PlainToHtml m_plainFilter;
+        Filters::TeiToHtml   m_teiFilter;
+        Filters::ThmlToHtml  m_thmlFilter;
+
+    };
+
 public: // methods:
 
     /**
@@ -129,13 +179,31 @@ public: // methods:
 
     /**
       \brief Sets the state of the given filter option.
+
+      Sword is only called if the state differs from the state last applied.
+
       \param[in] type The filter type whose state to set.
-      \param[in] state The new filter option state.
+      \param[in] state The new filter option state. Negative states are
+                       ignored.
     */
     void setOption(CSwordModuleInfo::FilterOption const & type, const int state);
 
+    /**
+      \brief Sets the states of all filter options.
+
+      Only the options whose states differ from the states last applied are
+      passed on to Sword, hence this is cheap to call repeatedly with the same
+      options.
+    */
     void setFilterOptions(const FilterOptions & options);
 
+    /**
+      \returns the filter option states last applied. Options which have not
+               been applied yet have a state of -1.
+    */
+    FilterOptions const & filterOptions() const noexcept
+    { return m_filterOptions; }
+
     /** \returns the language for the international booknames of Sword. */
     QString booknameLanguage() const;
 
@@ -164,10 +232,14 @@ public: // methods:
       \returns The global config object containing the configs of all modules
                merged together.
     */
-    sword::SWConfig * getConfig() const { return m_manager.config; }
+    sword::SWConfig * getConfig() const { return m_manager->config; }
 
     /**
       \brief Reloads all Sword modules.
+
+      Only works which were installed, updated or removed are added to or
+      removed from the model. Other works keep their CSwordModuleInfo objects
+      and the data cached by these.
     */
     void reloadModules();
 
@@ -205,40 +277,40 @@ public: // methods:
     void deleteOrphanedIndices();
 
     QString prefixPath() const
-    { return QString::fromLatin1(m_manager.prefixPath); }
+    { return QString::fromLatin1(m_manager->prefixPath); }
 
-    sword::SWMgr & raw() { return m_manager; }
+    sword::SWMgr & raw() { return *m_manager; }
 
 Q_SIGNALS:
 
     void sigSwordSetupChanged();
 
-private: // fields:
-
-    struct Private: public sword::SWMgr {
-
-    // Methods:
+private: // methods:
 
-        using sword::SWMgr::SWMgr;
+    /** \returns a new Sword manager for the path given on construction. */
+    std::unique_ptr<Private> createManager() const;
 
-        void shutdownModules();
-        void reloadConfig();
-        void addRenderFilters(sword::SWModule * module,
-                              sword::ConfigEntMap & section) override;
-
-    // Fields:
+    /**
+      \returns a new work for the given module of the current manager or
+               nullptr if the module is not supported.
+    */
+    std::unique_ptr<CSwordModuleInfo> createModuleInfo(
+            sword::SWModule & module);
 
-        Filters::GbfToHtml   m_gbfFilter;
-        Filters::OsisToHtml  m_osisFilter;
-        Filters::PlainToHtml m_plainFilter;
-        Filters::TeiToHtml   m_teiFilter;
-        Filters::ThmlToHtml  m_thmlFilter;
+private: // fields:
 
-    } m_manager;
+    /**
+      \brief The path of the constructor creating the manager, or no value for
+             the regular instance.
+    */
+    std::optional<QString> const m_path;
+    bool const m_augmentHome;
+    std::unique_ptr<Private> m_manager;
 
     std::shared_ptr<BtBookshelfModel> const m_dataModel;
     std::shared_ptr<AvailableLanguagesCacheContainer const>
             m_availableLanguagesCache;
+    FilterOptions m_filterOptions;
 
     static CSwordBackend * m_instance;
 
@@ -0,0 +1,121 @@
+/*********
+*
+* In the name of the Father, and of the Son, and of the Holy Spirit.
+*
+* This file is part of BibleTime's source code, https://bibletime.info/
+*
+* Copyright 1999-2021 by the BibleTime developers.
+* The BibleTime source code is licensed under the GNU General Public License
+* version 2.0.
+*
+**********/
+
+#include "btbooktreemodel.h"
+
+#include <cstddef>
+#include "../drivers/btbooktreeindex.h"
+#include "../drivers/cswordbookmoduleinfo.h"
+
+
+BtBookTreeModel::BtBookTreeModel(QObject * const parent)
+    : QAbstractItemModel(parent)
+{}
+
+void BtBookTreeModel::setModule(CSwordBookModuleInfo const * const module) {
+    if (module == m_module)
+        return;
+    beginResetModel();
+    m_module = module;
+    m_treeIndex = module ? &module->treeIndex() : nullptr;
+    m_fetched.assign(m_treeIndex
+                     ? static_cast<std::size_t>(m_treeIndex->size())
+                     : 0u,
+                     false);
+    if (m_treeIndex)
+        m_fetched[0u] = true; // The top level is always present
+    endResetModel();
+}
+
+QModelIndex BtBookTreeModel::indexOfNode(int const node) {
+    if (!m_treeIndex || node <= 0 || !m_treeIndex->contains(node))
+        return {};
+    auto const parentNode = m_treeIndex->node(node).parent;
+    auto const parentIndex = indexOfNode(parentNode);
+    if (!m_fetched[static_cast<std::size_t>(parentNode)])
+        fetchMore(parentIndex);
+    return createIndex(m_treeIndex->node(node).row, 0, node);
+}
+
+int BtBookTreeModel::nodeOf(QModelIndex const & index) const noexcept {
+    if (!index.isValid())
+        return 0;
+    return static_cast<int>(index.internalId());
+}
+
+QModelIndex BtBookTreeModel::index(int const row,
+                                   int const column,
+                                   QModelIndex const & parent) const
+{
+    if (column != 0 || row < 0 || row >= rowCount(parent))
+        return {};
+    auto const & children = m_treeIndex->node(nodeOf(parent)).children;
+    return createIndex(row, 0, children[static_cast<std::size_t>(row)]);
+}
+
+QModelIndex BtBookTreeModel::parent(QModelIndex const & index) const {
+    if (!m_treeIndex || !index.isValid())
+        return {};
+    auto const parentNode = m_treeIndex->node(nodeOf(index)).parent;
+    if (parentNode <= 0)
+        return {};
+    return createIndex(m_treeIndex->node(parentNode).row, 0, parentNode);
+}
+
+int BtBookTreeModel::rowCount(QModelIndex const & parent) const {
+    if (!m_treeIndex || parent.column() > 0)
+        return 0;
+    auto const node = nodeOf(parent);
+    if (!m_fetched[static_cast<std::size_t>(node)])
+        return 0;
+    return static_cast<int>(m_treeIndex->node(node).children.size());
+}
+
+int BtBookTreeModel::columnCount(QModelIndex const &) const { return 1; }
+
+bool BtBookTreeModel::hasChildren(QModelIndex const & parent) const {
+    if (!m_treeIndex || parent.column() > 0)
+        return false;
+    return !m_treeIndex->node(nodeOf(parent)).children.empty();
+}
+
+bool BtBookTreeModel::canFetchMore(QModelIndex const & parent) const {
+    if (!m_treeIndex || parent.column() > 0)
+        return false;
+    auto const node = nodeOf(parent);
+    return !m_fetched[static_cast<std::size_t>(node)]
+           && !m_treeIndex->node(node).children.empty();
+}
+
+void BtBookTreeModel::fetchMore(QModelIndex const & parent) {
+    if (!canFetchMore(parent))
+        return;
+    auto const node = nodeOf(parent);
+    auto const count = m_treeIndex->node(node).children.size();
+    beginInsertRows(parent, 0, static_cast<int>(count) - 1);
+    m_fetched[static_cast<std::size_t>(node)] = true;
+    endInsertRows();
+}
+
+QVariant BtBookTreeModel::data(QModelIndex const & index, int role) const {
+    if (!m_treeIndex || !index.isValid())
+        return {};
+    switch (role) {
+    case Qt::DisplayRole: [[fallthrough]];
+    case Qt::ToolTipRole:
+        return m_treeIndex->node(nodeOf(index)).name;
+    case KeyRole:
+        return m_treeIndex->path(nodeOf(index));
+    default:
+        return {};
+    }
+}
@@ -0,0 +1,84 @@
+/*********
+*
+* In the name of the Father, and of the Son, and of the Holy Spirit.
+*
+* This file is part of BibleTime's source code, https://bibletime.info/
+*
+* Copyright 1999-2021 by the BibleTime developers.
+* The BibleTime source code is licensed under the GNU General Public License
+* version 2.0.
+*
+**********/
+
+#pragma once
+
+#include <QAbstractItemModel>
+
+#include <QModelIndex>
+#include <QObject>
+#include <QVariant>
+#include <Qt>
+#include <vector>
+
+
+class BtBookTreeIndex;
+class CSwordBookModuleInfo;
+
+/**
+  \brief Model of the tree of sections of a generic book.
+
+  The model is backed by the BtBookTreeIndex of the book. The children of a
+  node are only added to the model when the view fetches them, e.g. when the
+  node is expanded. Model indexes carry the index of their node in the tree.
+*/
+class BtBookTreeModel final: public QAbstractItemModel {
+
+    Q_OBJECT
+
+public: // types:
+
+    enum Roles {
+        KeyRole = Qt::UserRole ///< The full key of the node, as QString.
+    };
+
+public: // methods:
+
+    BtBookTreeModel(QObject * parent = nullptr);
+
+    CSwordBookModuleInfo const * module() const noexcept { return m_module; }
+    void setModule(CSwordBookModuleInfo const * module);
+
+    /**
+      \returns the model index of the node with the given index in the tree,
+               fetching the children of all its ancestors as needed.
+    */
+    QModelIndex indexOfNode(int node);
+
+    /** \returns the index in the tree of the node of the given model index. */
+    int nodeOf(QModelIndex const & index) const noexcept;
+
+    QModelIndex index(int row,
+                      int column,
+                      QModelIndex const & parent = QModelIndex())
+            const final override;
+    QModelIndex parent(QModelIndex const & index) const final override;
+    int rowCount(QModelIndex const & parent = QModelIndex())
+            const final override;
+    int columnCount(QModelIndex const & parent = QModelIndex())
+            const final override;
+    bool hasChildren(QModelIndex const & parent = QModelIndex())
+            const final override;
+    bool canFetchMore(QModelIndex const & parent) const final override;
+    void fetchMore(QModelIndex const & parent) final override;
+    QVariant data(QModelIndex const & index,
+                  int role = Qt::DisplayRole) const final override;
+
+private: // fields:
+
+    CSwordBookModuleInfo const * m_module = nullptr;
+    BtBookTreeIndex const * m_treeIndex = nullptr;
+
+    /** Whether the children of the nodes have been added to the model. */
+    std::vector<bool> m_fetched;
+
+};
@@ -0,0 +1,107 @@
+/*********
+*
+* In the name of the Father, and of the Son, and of the Holy Spirit.
+*
+* This file is part of BibleTime's source code, https://bibletime.info/
+*
+* Copyright 1999-2021 by the BibleTime developers.
+* The BibleTime source code is licensed under the GNU General Public License
+* version 2.0.
+*
+**********/
+
+
+#include "btmoduletextfinder.h"
+
+#include <algorithm>
+#include <iterator>
+#include <QElapsedTimer>
+#include "../../util/btassert.h"
+#include "../../util/btconnect.h"
+
+
+namespace {
+
+/** The time to search rows for before handling other events. */
+constexpr qint64 const sliceMilliseconds = 10;
+
+} // anonymous namespace
+
+void BtFindMatchMap::append(int const row, int const count) {
+    BT_ASSERT(m_matches.empty() || m_matches.back().first < row);
+    BT_ASSERT(count > 0);
+    m_matches.emplace_back(row, count);
+}
+
+int BtFindMatchMap::matchCount(int const row) const noexcept {
+    auto const it =
+            std::lower_bound(m_matches.begin(),
+                             m_matches.end(),
+                             row,
+                             [](auto const & match, int const r) noexcept
+                             { return match.first < r; });
+    return (it != m_matches.end() && it->first == row) ? it->second : 0;
+}
+
+std::optional<FindState>
+BtFindMatchMap::next(FindState const & state) const noexcept {
+    if (matchCount(state.index) > state.subIndex)
+        return FindState{state.index, state.subIndex + 1};
+    auto const it =
+            std::upper_bound(m_matches.begin(),
+                             m_matches.end(),
+                             state.index,
+                             [](int const r, auto const & match) noexcept
+                             { return r < match.first; });
+    if (it == m_matches.end())
+        return {};
+    return FindState{it->first, 1};
+}
+
+std::optional<FindState>
+BtFindMatchMap::previous(FindState const & state) const noexcept {
+    if (auto const count = matchCount(state.index); count > 0) {
+        if (state.subIndex == 0) // Not yet at any match, use the first one
+            return FindState{state.index, 1};
+        if (state.subIndex > 1)
+            return FindState{state.index, std::min(state.subIndex, count) - 1};
+    }
+    auto const it =
+            std::lower_bound(m_matches.begin(),
+                             m_matches.end(),
+                             state.index,
+                             [](auto const & match, int const r) noexcept
+                             { return match.first < r; });
+    if (it == m_matches.begin())
+        return {};
+    auto const & match = *std::prev(it);
+    return FindState{match.first, match.second};
+}
+
+BtModuleTextFinder::BtModuleTextFinder(BtModuleTextModel const & model,
+                                       QObject * const parent)
+    : QObject(parent)
+    , m_model(model)
+    , m_entryCount(model.rowCount())
+{
+    m_timer.setInterval(0);
+    BT_CONNECT(&m_timer, &QTimer::timeout,
+               this, &BtModuleTextFinder::searchRows);
+    if (!isFinished())
+        m_timer.start();
+}
+
+void BtModuleTextFinder::searchRows() {
+    QElapsedTimer sliceTimer;
+    sliceTimer.start();
+    do {
+        auto const row = m_searchedRows;
+        if (auto const count = m_model.highlightCount(row))
+            m_matchMap.append(row, count);
+        ++m_searchedRows;
+    } while (!isFinished() && !sliceTimer.hasExpired(sliceMilliseconds));
+
+    if (isFinished())
+        m_timer.stop();
+    Q_EMIT rowsSearched();
+}
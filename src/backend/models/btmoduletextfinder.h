@@ -0,0 +1,122 @@
+/*********
+*
+* In the name of the Father, and of the Son, and of the Holy Spirit.
+*
+* This file is part of BibleTime's source code, https://bibletime.info/
+*
+* Copyright 1999-2021 by the BibleTime developers.
+* The BibleTime source code is licensed under the GNU General Public License
+* version 2.0.
+*
+**********/
+
+
+#pragma once
+
+#include <QObject>
+
+#include <optional>
+#include <QTimer>
+#include <utility>
+#include <vector>
+#include "btmoduletextmodel.h"
+
+
+/**
+  \brief The number of matches of the searched words per model row.
+
+  Only rows with matches are stored, sorted by row, so that finding the next or
+  previous match is a binary search.
+*/
+class BtFindMatchMap {
+
+public: // methods:
+
+    /**
+      \brief Adds a row with matches.
+      \pre Rows are added in ascending order.
+      \pre count > 0
+    */
+    void append(int row, int count);
+
+    bool empty() const noexcept { return m_matches.empty(); }
+
+    /** \returns the number of matches in the given row. */
+    int matchCount(int row) const noexcept;
+
+    /**
+      \returns the state of the match following the given one, if any.
+      \param[in] state The current state. A subIndex of 0 denotes a position
+                       in front of the first match of the row.
+    */
+    std::optional<FindState> next(FindState const & state) const noexcept;
+
+    /**
+      \returns the state of the match preceding the given one, if any.
+      \param[in] state The current state. A subIndex of 0 denotes a position
+                       in front of the first match of the row.
+    */
+    std::optional<FindState> previous(FindState const & state) const noexcept;
+
+private: // fields:
+
+    /** Pairs of row and number of matches, sorted by row. */
+    std::vector<std::pair<int, int>> m_matches;
+
+};
+
+/**
+  \brief Counts the highlighted words for each row of a module text model.
+
+  The words are counted in the same rendered and highlighted text the model
+  shows, so the counts match the highlights selected by FindState::subIndex.
+  Rendering uses the Sword modules of the backend, which may only be used by
+  the GUI thread. Hence the rows are searched in order on the GUI thread, in
+  slices of a few milliseconds whenever the event loop is idle, so the GUI
+  stays responsive. Destroying the finder cancels the search.
+*/
+class BtModuleTextFinder: public QObject {
+
+    Q_OBJECT
+
+public: // methods:
+
+    /**
+      \param[in] model The model to search. It must outlive the finder and
+                       the finder must be destroyed whenever the model, its
+                       rendering options or its highlighted words change.
+    */
+    BtModuleTextFinder(BtModuleTextModel const & model,
+                       QObject * parent = nullptr);
+
+    /** \returns whether all rows have been searched. */
+    bool isFinished() const noexcept { return m_searchedRows >= m_entryCount; }
+
+    /**
+      \returns the number of rows searched so far. These are the rows from
+               0 up to but excluding the returned row.
+    */
+    int searchedRows() const noexcept { return m_searchedRows; }
+
+    /** \returns the matches found in the rows searched so far. */
+    BtFindMatchMap const & matchMap() const noexcept { return m_matchMap; }
+
+Q_SIGNALS:
+
+    /** Emitted after each slice of rows has been searched. */
+    void rowsSearched();
+
+private: // methods:
+
+    void searchRows();
+
+private: // fields:
+
+    BtModuleTextModel const & m_model;
+    int const m_entryCount;
+
+    int m_searchedRows = 0;
+    BtFindMatchMap m_matchMap;
+    QTimer m_timer;
+
+};
@@ -13,21 +13,37 @@
 #include <QTextEdit>
 #include "btmoduletextmodel.h"
 
+#include <cstdlib>
+#include <QFileInfo>
+#include <QStringList>
 #include "../../util/btassert.h"
+#include "../../util/btconnect.h"
 #include "../drivers/cswordmoduleinfo.h"
 #include "../drivers/cswordbiblemoduleinfo.h"
 #include "../drivers/cswordbookmoduleinfo.h"
 #include "../drivers/cswordlexiconmoduleinfo.h"
 #include "../cswordmodulesearch.h"
+#include "../keys/btversificationtable.h"
 #include "../keys/cswordtreekey.h"
 #include "../keys/cswordversekey.h"
+#include "../managers/cdisplaytemplatemgr.h"
 #include "../managers/colormanager.h"
 #include "../managers/cswordbackend.h"
 #include "../rendering/ctextrendering.h"
+#include "btrenderedtextcache.h"
 
 
 namespace {
 
+/** The number of rows to prefetch in each direction. */
+constexpr int const prefetchRows = 100;
+
+/** The maximum size of the texts of the rendered rows in bytes. */
+constexpr std::size_t const renderedRowsBudget = 8u * 1024u * 1024u;
+
+/** The number of consecutive rows stored together in the persistent cache. */
+constexpr int const rowsPerBucket = 64;
+
 DisplayOptions const defaultDisplayOptions = []() noexcept {
     DisplayOptions opts;
     opts.lineBreaks = 1;
@@ -62,7 +78,20 @@ BtModuleTextModel::BtModuleTextModel(QObject *parent)
     , m_maxEntries(0)
     , m_textFilter(nullptr)
     , m_displayRendering(defaultDisplayOptions, defaultFilterOptions)
-{}
+{
+    // Prefetch when the event loop is idle:
+    m_prefetchTimer.setInterval(0);
+    BT_CONNECT(&m_prefetchTimer, &QTimer::timeout,
+               this, &BtModuleTextModel::prefetchNextRow);
+
+    // Write newly rendered rows to disk once rendering has settled:
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(2000);
+    BT_CONNECT(&m_saveTimer, &QTimer::timeout,
+               this, &BtModuleTextModel::saveRenderedRows);
+}
+
+BtModuleTextModel::~BtModuleTextModel() { saveRenderedRows(); }
 
 void BtModuleTextModel::reloadModules() {
     m_moduleInfoList.clear();
@@ -72,25 +101,26 @@ void BtModuleTextModel::reloadModules() {
                         moduleName));
 
     beginResetModel();
+    clearRenderedRows();
     const CSwordModuleInfo* firstModule = m_moduleInfoList.at(0);
+    m_versificationTable = nullptr;
     if (isBible() || isCommentary()) {
         CSwordBibleModuleInfo const * const m =
             static_cast<const CSwordBibleModuleInfo *>(firstModule);
-        m_firstEntry = m->lowerBound().index();
+        auto const lowerBound = m->lowerBound();
+        m_firstEntry = lowerBound.index();
         m_maxEntries = m->upperBound().index() - m_firstEntry + 1;
+        m_versificationTable =
+                &BtVersificationTable::instance(
+                    lowerBound.versification().toUtf8().constData());
     } else if(isLexicon()) {
         m_maxEntries =
                 static_cast<CSwordLexiconModuleInfo const *>(firstModule)
                 ->entries().size();
     } else if(isBook()) {
-        sword::TreeKeyIdx tk(
-                    *static_cast<CSwordBookModuleInfo const *>(firstModule)
-                    ->tree());
-        tk.root();
-        tk.firstChild();
-        BT_ASSERT(tk.getOffset() == 4);
-        tk.setPosition(sword::BOTTOM);
-        m_maxEntries = tk.getOffset() / 4;
+        m_maxEntries =
+                static_cast<CSwordBookModuleInfo const *>(firstModule)
+                ->treeIndex().size();
     }
 
     endResetModel();
@@ -104,19 +134,7 @@ void BtModuleTextModel::setModules(const QStringList& modules) {
 
 QVariant BtModuleTextModel::data(const QModelIndex & index, int role) const {
 
-    QString text;
-    if (isBible() || isCommentary())
-        text = verseData(index, role);
-    else if (isBook())
-        text = bookData(index, role);
-    else if (isLexicon())
-        text = lexiconData(index, role);
-    else
-        text = QStringLiteral("invalid");
-
-    if (m_textFilter) {
-        text = m_textFilter->processText(text);
-    }
+    QString text = renderedText(index.row(), role);
 
     if ( ! m_highlightWords.isEmpty()) {
         QString t = CSwordModuleSearch::highlightSearchedText(text, m_highlightWords);
@@ -140,6 +158,216 @@ QVariant BtModuleTextModel::data(const QModelIndex & index, int role) const {
     return QVariant(text);
 }
 
+int BtModuleTextModel::highlightCount(int const row) const {
+    if (m_highlightWords.isEmpty())
+        return 0;
+    /* Rows not kept in memory are rendered without keeping them, so counting
+       all rows does not replace the rows around the current position: */
+    static constexpr int const role = ModuleEntry::Text0Role;
+    auto const it = m_renderedRows.constFind(row);
+    auto const text =
+            (it != m_renderedRows.cend() && it->contains(role))
+            ? it->value(role)
+            : renderText(index(row, 0), role);
+    return CSwordModuleSearch::highlightSearchedText(text, m_highlightWords)
+            .count(QStringLiteral("\"highlightwords\""));
+}
+
+QString BtModuleTextModel::renderText(const QModelIndex & index,
+                                      int role) const
+{
+    QString text;
+    if (isBible() || isCommentary())
+        text = verseData(index, role);
+    else if (isBook())
+        text = bookData(index, role);
+    else if (isLexicon())
+        text = lexiconData(index, role);
+    else
+        text = QStringLiteral("invalid");
+
+    if (m_textFilter) {
+        text = m_textFilter->processText(text);
+    }
+    return text;
+}
+
+bool BtModuleTextModel::isRenderedRowRole(int const role) const {
+    if (role != ModuleEntry::TextRole
+        && (role < ModuleEntry::Text0Role || role > ModuleEntry::Text9Role))
+        return false;
+    /* Personal commentaries might be changed by other windows. The text of
+       encrypted works changes when they are unlocked and must not be written
+       to the cache directory in clear text: */
+    for (auto const * const module : m_moduleInfoList)
+        if (module->isWritable() || module->isEncrypted())
+            return false;
+    return true;
+}
+
+QString BtModuleTextModel::renderedText(int const row, int const role) const {
+    if (!isRenderedRowRole(role))
+        return renderText(index(row, 0), role);
+
+    auto const bucket = row / rowsPerBucket;
+    if (!m_loadedBuckets.contains(bucket))
+        loadRenderedBucket(bucket);
+
+    auto & renderedRow = m_renderedRows[row];
+    if (auto const it = renderedRow.constFind(role); it != renderedRow.cend())
+        return *it;
+    auto text = renderText(index(row, 0), role);
+    renderedRow.insert(role, text);
+    m_renderedRowsSize += static_cast<std::size_t>(text.size()) * sizeof(QChar);
+    m_unsavedBuckets.insert(bucket);
+    m_saveTimer.start();
+    evictRenderedRows(row);
+    return text;
+}
+
+void BtModuleTextModel::evictRenderedRows(int const keepRow) const {
+    // Keep to the memory budget by discarding the rows farthest away:
+    while (m_renderedRowsSize > renderedRowsBudget
+           && m_renderedRows.size() > 1)
+    {
+        auto farthest = m_renderedRows.begin();
+        for (auto it = m_renderedRows.begin(); it != m_renderedRows.end(); ++it)
+            if (std::abs(it.key() - m_prefetchCenter)
+                > std::abs(farthest.key() - m_prefetchCenter))
+                farthest = it;
+        if (farthest.key() == keepRow)
+            break;
+        for (auto const & t : *farthest)
+            m_renderedRowsSize -=
+                    static_cast<std::size_t>(t.size()) * sizeof(QChar);
+        // Reload the other rows of the bucket from disk when needed again:
+        m_loadedBuckets.remove(farthest.key() / rowsPerBucket);
+        m_renderedRows.erase(farthest);
+    }
+}
+
+void BtModuleTextModel::loadRenderedBucket(int const bucket) const {
+    m_loadedBuckets.insert(bucket);
+    auto const rows = RenderedTextCache::load(renderedRowsContext(), bucket);
+    for (auto it = rows.cbegin(); it != rows.cend(); ++it) {
+        if (it.key() / rowsPerBucket != bucket)
+            continue;
+        auto & renderedRow = m_renderedRows[it.key()];
+        for (auto roleIt = it->cbegin(); roleIt != it->cend(); ++roleIt) {
+            if (!isRenderedRowRole(roleIt.key())
+                || renderedRow.contains(roleIt.key()))
+                continue;
+            renderedRow.insert(roleIt.key(), *roleIt);
+            m_renderedRowsSize +=
+                    static_cast<std::size_t>(roleIt->size()) * sizeof(QChar);
+        }
+    }
+    evictRenderedRows(bucket * rowsPerBucket);
+}
+
+void BtModuleTextModel::saveRenderedRows() {
+    m_saveTimer.stop();
+    for (auto const bucket : m_unsavedBuckets) {
+        RenderedTextCache::Rows rows;
+        for (int row = bucket * rowsPerBucket;
+             row < (bucket + 1) * rowsPerBucket;
+             ++row)
+            if (auto const it = m_renderedRows.constFind(row);
+                it != m_renderedRows.cend() && !it->isEmpty())
+                rows.insert(row, *it);
+        RenderedTextCache::save(m_renderedRowsContext, bucket, rows);
+    }
+    m_unsavedBuckets.clear();
+}
+
+QString const & BtModuleTextModel::renderedRowsContext() const {
+    if (!m_renderedRowsContext.isEmpty())
+        return m_renderedRowsContext;
+
+    QStringList context{QStringLiteral(BT_VERSION)};
+    for (auto const * const module : m_moduleInfoList) {
+        // Reinstalling a module changes the time stamp of its data:
+        QFileInfo const dataPath(
+                    module->config(CSwordModuleInfo::AbsoluteDataPath));
+        context << module->name()
+                << module->config(CSwordModuleInfo::ModuleVersion)
+                << QString::number(
+                       dataPath.lastModified().toMSecsSinceEpoch());
+    }
+    auto const & d = m_displayRendering.displayOptions();
+    auto const & f = m_displayRendering.filterOptions();
+    for (int const option : {d.lineBreaks,
+                             d.verseNumbers,
+                             f.footnotes,
+                             f.strongNumbers,
+                             f.headings,
+                             f.morphTags,
+                             f.lemmas,
+                             f.hebrewPoints,
+                             f.hebrewCantillation,
+                             f.greekAccents,
+                             f.textualVariants,
+                             f.redLetterWords,
+                             f.scriptureReferences,
+                             f.morphSegmentation})
+        context << QString::number(option);
+    context << CDisplayTemplateMgr::activeTemplateName()
+            << ColorManager::getForegroundColor()
+            << ColorManager::getBackgroundColor()
+            << ColorManager::getBackgroundHighlightColor()
+            << ColorManager::getCrossRefColor()
+            << CSwordBackend::instance().booknameLanguage();
+    m_renderedRowsContext = context.join(QLatin1Char('\n'));
+    return m_renderedRowsContext;
+}
+
+void BtModuleTextModel::prefetchAround(int const row) {
+    if (row == m_prefetchCenter && m_prefetchTimer.isActive())
+        return;
+    m_prefetchCenter = row;
+    m_prefetchQueue.clear();
+    for (int i = prefetchRows; i > 0; --i)
+        if (row - i >= 0)
+            m_prefetchQueue.push_back(row - i);
+    for (int i = prefetchRows; i > 0; --i)
+        if (row + i < m_maxEntries)
+            m_prefetchQueue.push_back(row + i);
+    if (m_prefetchQueue.empty()) {
+        m_prefetchTimer.stop();
+    } else {
+        m_prefetchTimer.start();
+    }
+}
+
+void BtModuleTextModel::prefetchNextRow() {
+    // The queue is processed from its back, following rows come first:
+    while (!m_prefetchQueue.empty()) {
+        auto const row = m_prefetchQueue.back();
+        m_prefetchQueue.pop_back();
+        if (m_renderedRows.contains(row))
+            continue;
+        if (!isRenderedRowRole(ModuleEntry::Text0Role)) {
+            m_prefetchQueue.clear();
+            break;
+        }
+        for (int column = 0; column < m_moduleInfoList.size(); ++column)
+            renderedText(row, ModuleEntry::Text0Role + column);
+        break;
+    }
+    if (m_prefetchQueue.empty())
+        m_prefetchTimer.stop();
+}
+
+void BtModuleTextModel::clearRenderedRows() {
+    saveRenderedRows();
+    m_prefetchQueue.clear();
+    m_prefetchTimer.stop();
+    m_renderedRows.clear();
+    m_renderedRowsSize = 0u;
+    m_renderedRowsContext.clear();
+    m_loadedBuckets.clear();
+}
+
 QString BtModuleTextModel::lexiconData(const QModelIndex & index, int role) const {
     int row = index.row();
 
@@ -198,19 +426,21 @@ static int getColumnFromRole(int role) {
 
 QString BtModuleTextModel::verseData(const QModelIndex & index, int role) const {
     int row = index.row();
-    CSwordVerseKey key = indexToVerseKey(row);
-    int verse = key.verse();
+    int verse = indexToVerse(row);
 
     if (role >= ModuleEntry::TextRole && role <= ModuleEntry::Title9Role) {
         if (verse == 0)
             return QString();
         QString text;
 
-        QString chapterTitle;
-        if (verse == 1)
-            chapterTitle =
-                    QStringLiteral("%1 %2").arg(key.bookName(),
-                                                QString::number(key.chapter()));
+        auto const chapterTitleOf =
+                [verse](CSwordVerseKey const & key) {
+                    if (verse != 1)
+                        return QString();
+                    return QStringLiteral("%1 %2")
+                            .arg(key.bookName(),
+                                 QString::number(key.chapter()));
+                };
 
         BtConstModuleList modules;
         if ( role == ModuleEntry::TextRole) {
@@ -223,20 +453,18 @@ QString BtModuleTextModel::verseData(const QModelIndex & index, int role) const
             else
                 module = m_moduleInfoList.at(column);
             modules.append(module);
-            CSwordVerseKey mKey(module);
-            mKey.setKey(key.key());
 
             // Title only for verse 1 of Personal commentary
             if (role >= ModuleEntry::Title0Role && role <= ModuleEntry::Title9Role) {
                 if (module->isWritable() && verse == 1)
                     return QStringLiteral("<center><h3>%1</h3></center>")
-                            .arg(chapterTitle);
+                            .arg(chapterTitleOf(indexToVerseKey(row)));
                 return {};
             }
 
             // Personal commentary
             if (module->isWritable()) {
-                auto const & rawText = mKey.rawText();
+                auto const & rawText = indexToVerseKey(row, *module).rawText();
                 auto text =
                         QStringLiteral("%1 %2")
                         .arg(QString::number(verse),
@@ -251,6 +479,8 @@ QString BtModuleTextModel::verseData(const QModelIndex & index, int role) const
             }
         }
 
+        // Only construct the key when rendering needs it:
+        CSwordVerseKey const key = indexToVerseKey(row);
         if (!key.key().isEmpty())
             text +=
                 m_displayRendering.renderDisplayEntry(
@@ -260,7 +490,7 @@ QString BtModuleTextModel::verseData(const QModelIndex & index, int role) const
                     ? Rendering::CTextRendering::KeyTreeItem::Settings::SimpleKey
                     : Rendering::CTextRendering::KeyTreeItem::Settings::NoKey);
 
-        text.replace(QStringLiteral("#CHAPTERTITLE#"), chapterTitle);
+        text.replace(QStringLiteral("#CHAPTERTITLE#"), chapterTitleOf(key));
         text.replace(QStringLiteral("#TEXT_ALIGN#"), QStringLiteral("left"));
         text = ColorManager::replaceColors(text);
         return text;
@@ -349,21 +579,27 @@ int BtModuleTextModel::verseKeyToIndex(const CSwordVerseKey& key) const {
     return index;
 }
 
-CSwordVerseKey BtModuleTextModel::indexToVerseKey(int index) const
-{ return indexToVerseKey(index, *m_moduleInfoList.front()); }
+CSwordVerseKey BtModuleTextModel::indexToVerseKey(int index) const {
+    CSwordVerseKey key(m_moduleInfoList.front());
+    key.setIntros(true);
+    key.setIndex(index + m_firstEntry);
+    return key;
+}
 
 CSwordVerseKey
 BtModuleTextModel::indexToVerseKey(int index,
                                    CSwordModuleInfo const & module) const
 {
-    CSwordVerseKey key(&module);
-    key.setIntros(true);
-    key.setIndex(index + m_firstEntry);
+    // Rows are indexes in the versification of the first module:
+    CSwordVerseKey key(indexToVerseKey(index));
+    key.setModule(&module);
     return key;
 }
 
-int BtModuleTextModel::indexToVerse(int index) const
-{
+int BtModuleTextModel::indexToVerse(int index) const {
+    if (m_versificationTable)
+        return m_versificationTable->verse(index + m_firstEntry).verse;
+
     const CSwordModuleInfo* module = m_moduleInfoList.at(0);
     CSwordVerseKey key(module);
 
@@ -409,7 +645,7 @@ int BtModuleTextModel::getFirstEntryIndex() const {
 }
 
 void BtModuleTextModel::setFindState(std::optional<FindState> findState) {
-    if (m_findState && m_findState->index != findState->index) {
+    if (m_findState && (!findState || m_findState->index != findState->index)) {
         QModelIndex oldIndexToClear = index(m_findState->index, 0);
         m_findState = std::move(findState);
         Q_EMIT dataChanged(oldIndexToClear, oldIndexToClear);
@@ -424,6 +660,7 @@ void BtModuleTextModel::setFindState(std::optional<FindState> findState) {
 void BtModuleTextModel::setHighlightWords(
         const QString& highlightWords, bool /* caseSensitive */) {
     beginResetModel();
+    clearRenderedRows();
     m_highlightWords = highlightWords;
     endResetModel();
 }
@@ -432,6 +669,7 @@ void BtModuleTextModel::setDisplayOptions(const DisplayOptions & displayOptions)
     if (m_displayRendering.displayOptions().displayOptionsAreEqual(displayOptions))
         return;
     beginResetModel();
+    clearRenderedRows();
     m_displayRendering.setDisplayOptions(displayOptions);
     endResetModel();
 }
@@ -440,6 +678,7 @@ void BtModuleTextModel::setFilterOptions(FilterOptions filterOptions) {
     if (m_displayRendering.filterOptions().filterOptionsAreEqual(filterOptions))
             return;
     beginResetModel();
+    clearRenderedRows();
     m_displayRendering.setFilterOptions(filterOptions);
     endResetModel();
 }
@@ -447,6 +686,7 @@ void BtModuleTextModel::setFilterOptions(FilterOptions filterOptions) {
 void BtModuleTextModel::setTextFilter(BtModuleTextFilter * textFilter) {
     BT_ASSERT(m_textFilter == nullptr);
     m_textFilter = textFilter;
+    clearRenderedRows();
 }
 
 bool BtModuleTextModel::setData(
@@ -456,6 +696,14 @@ bool BtModuleTextModel::setData(
     auto const & module = *m_moduleInfoList.at(getColumnFromRole(role));
     CSwordVerseKey mKey(indexToVerseKey(index.row(), module));
     const_cast<CSwordModuleInfo &>(module).write(&mKey, value.toString());
+    if (auto const it = m_renderedRows.find(index.row());
+        it != m_renderedRows.end())
+    {
+        for (auto const & t : *it)
+            m_renderedRowsSize -=
+                    static_cast<std::size_t>(t.size()) * sizeof(QChar);
+        m_renderedRows.erase(it);
+    }
     Q_EMIT dataChanged(index, index);
     return true;
 }
@@ -12,10 +12,15 @@
 
 #pragma once
 
+#include <cstddef>
 #include <optional>
 #include <QAbstractListModel>
 #include <QColor>
+#include <QHash>
+#include <QSet>
 #include <QStringList>
+#include <QTimer>
+#include <vector>
 #include "../btglobal.h"
 #include "../drivers/btmodulelist.h"
 #include "../keys/cswordversekey.h"
@@ -23,6 +28,7 @@
 #include "../rendering/cdisplayrendering.h"
 
 
+class BtVersificationTable;
 class CSwordModuleInfo;
 
 /** For the BtFindWidget buttons (previous, next) */
@@ -105,6 +111,7 @@ class BtModuleTextModel: public QAbstractListModel {
 public:
 
     BtModuleTextModel(QObject *parent = nullptr);
+    ~BtModuleTextModel() override;
 
     /** Convert index(row) into CSwordVerseKey. */
     CSwordVerseKey indexToVerseKey(int index) const;
@@ -112,7 +119,7 @@ public:
     /** Convert index(row) into verse. */
     int indexToVerse(int index) const;
 
-    /** Convert index(row) into CSwordVerseKey. */
+    /** Convert index(row) into CSwordVerseKey mapped to the module. */
     CSwordVerseKey indexToVerseKey(int index,
                                    CSwordModuleInfo const & module) const;
 
@@ -153,6 +160,12 @@ public:
     /** Set the color of word that are highlighted */
     void setHighlightWords(const QString& highlightWords, bool caseSensitive);
 
+    /**
+      \returns the number of highlighted words in the first column of the row,
+               as shown by data().
+    */
+    int highlightCount(int row) const;
+
     /** Used by model to get the roleNames and corresponding role numbers. */
     QHash<int, QByteArray> roleNames() const override;
 
@@ -168,8 +181,42 @@ public:
     /** Set the text options used for rendering module text. */
     void setTextFilter(BtModuleTextFilter * textFilter);
 
+    /**
+      \brief Renders the rows around the given row when the event loop is idle.
+
+      The rows following the given row are rendered first, then the preceding
+      rows, one row per event loop iteration. A prefetch in progress around
+      another row is cancelled.
+    */
+    void prefetchAround(int row);
+
+    /**
+      \brief Discards all rendered rows, e.g. after the colors have changed.
+
+      Rendered rows not yet written to the persistent cache are written first.
+    */
+    void clearRenderedRows();
+
 private:
 
+    /** Renders one row of the prefetch queue. */
+    void prefetchNextRow();
+
+    /** \returns the text of the row for the role, rendered if needed. */
+    QString renderedText(int row, int role) const;
+    QString renderText(const QModelIndex & index, int role) const;
+    bool isRenderedRowRole(int role) const;
+    void evictRenderedRows(int keepRow) const;
+
+    /** Loads the rows of the bucket from the persistent cache. */
+    void loadRenderedBucket(int bucket) const;
+
+    /** Writes the newly rendered rows to the persistent cache. */
+    void saveRenderedRows();
+
+    /** \returns the context of the rendered rows in the persistent cache. */
+    QString const & renderedRowsContext() const;
+
     CSwordTreeKey indexToBookKey(int index) const;
 
     bool isBible() const;
@@ -189,7 +236,20 @@ private:
 
     int m_firstEntry;
     int m_maxEntries;
+    /** The versification of the first module of Bibles and commentaries. */
+    BtVersificationTable const * m_versificationTable = nullptr;
     BtModuleTextFilter * m_textFilter;
     Rendering::CDisplayRendering m_displayRendering;
     std::optional<FindState> m_findState;
+
+    /** The rendered texts of rows by row and role. */
+    mutable QHash<int, QHash<int, QString>> m_renderedRows;
+    mutable std::size_t m_renderedRowsSize = 0u;
+    mutable QString m_renderedRowsContext;
+    mutable QSet<int> m_loadedBuckets;
+    mutable QSet<int> m_unsavedBuckets;
+    mutable QTimer m_saveTimer;
+    int m_prefetchCenter = 0;
+    std::vector<int> m_prefetchQueue;
+    QTimer m_prefetchTimer;
 };
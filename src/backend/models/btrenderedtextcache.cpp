@@ -0,0 +1,151 @@
+/*********
+*
+* In the name of the Father, and of the Son, and of the Holy Spirit.
+*
+* This file is part of BibleTime's source code, https://bibletime.info/
+*
+* Copyright 1999-2021 by the BibleTime developers.
+* The BibleTime source code is licensed under the GNU General Public License
+* version 2.0.
+*
+**********/
+
+#include "btrenderedtextcache.h"
+
+#include <optional>
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include "../../util/directory.h"
+
+
+// Change it once the format changed to make all systems rebuild their caches
+#define CACHE_FORMAT "1"
+
+namespace DU = util::directory;
+
+namespace {
+
+/** The maximum total size of the cache files in bytes. */
+constexpr qint64 const cacheBudget = 32 * 1024 * 1024;
+
+/** The total size of the cache files, if already known. */
+std::optional<qint64> cacheSize;
+
+QString cacheDirPath() {
+    return QStringLiteral("%1/renderedtext")
+            .arg(DU::getUserCacheDir().absolutePath());
+}
+
+QString cacheFilePath(QString const & context, int const bucket) {
+    auto const contextHash =
+            QCryptographicHash::hash(context.toUtf8(),
+                                      QCryptographicHash::Sha1).toHex();
+    return QStringLiteral("%1/%2-%3.cache")
+            .arg(cacheDirPath(),
+                 QString::fromLatin1(contextHash),
+                 QString::number(bucket));
+}
+
+/** Removes the least recently used files until the cache fits its budget. */
+void prune() {
+    QDir const dir(cacheDirPath());
+    auto const files =
+            dir.entryInfoList({QStringLiteral("*.cache")},
+                              QDir::Files,
+                              QDir::Time | QDir::Reversed);
+    qint64 size = 0;
+    for (auto const & file : files)
+        size += file.size();
+    for (auto const & file : files) {
+        if (size <= cacheBudget)
+            break;
+        if (QFile::remove(file.absoluteFilePath()))
+            size -= file.size();
+    }
+    cacheSize = size;
+}
+
+RenderedTextCache::Rows read(QFile & file,
+                             QString const & context,
+                             int const bucket)
+{
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+    QDataStream s(qUncompress(file.readAll()));
+    s.setVersion(QDataStream::Qt_5_12);
+    QString format;
+    QString cachedContext;
+    qint32 cachedBucket;
+    RenderedTextCache::Rows rows;
+    s >> format >> cachedContext >> cachedBucket >> rows;
+    if (s.status() != QDataStream::Ok
+        || format != QStringLiteral(CACHE_FORMAT)
+        || cachedContext != context
+        || cachedBucket != bucket)
+        return {};
+    return rows;
+}
+
+} // anonymous namespace
+
+namespace RenderedTextCache {
+
+Rows load(QString const & context, int const bucket) {
+    QFile file(cacheFilePath(context, bucket));
+    auto rows = read(file, context, bucket);
+    // Mark the file as recently used to keep it when pruning:
+    if (!rows.isEmpty())
+        file.setFileTime(QDateTime::currentDateTimeUtc(),
+                         QFileDevice::FileModificationTime);
+    return rows;
+}
+
+void save(QString const & context, int const bucket, Rows const & rows) {
+    if (rows.isEmpty() || !QDir().mkpath(cacheDirPath()))
+        return;
+    auto const path = cacheFilePath(context, bucket);
+
+    Rows merged;
+    qint64 oldSize = 0;
+    {
+        QFile oldFile(path);
+        merged = read(oldFile, context, bucket);
+        oldSize = oldFile.size();
+    }
+    for (auto it = rows.cbegin(); it != rows.cend(); ++it) {
+        auto & mergedRow = merged[it.key()];
+        for (auto roleIt = it->cbegin(); roleIt != it->cend(); ++roleIt)
+            mergedRow.insert(roleIt.key(), *roleIt);
+    }
+
+    QByteArray data;
+    {
+        QDataStream s(&data, QIODevice::WriteOnly);
+        s.setVersion(QDataStream::Qt_5_12);
+        s << QStringLiteral(CACHE_FORMAT) << context
+          << static_cast<qint32>(bucket) << merged;
+    }
+    data = qCompress(data);
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)
+        || file.write(data) != data.size()
+        || !file.commit())
+        return;
+
+    if (!cacheSize) {
+        prune();
+    } else {
+        *cacheSize += data.size() - oldSize;
+        if (*cacheSize > cacheBudget)
+            prune();
+    }
+}
+
+} /* namespace RenderedTextCache */
@@ -0,0 +1,47 @@
+/*********
+*
+* In the name of the Father, and of the Son, and of the Holy Spirit.
+*
+* This file is part of BibleTime's source code, https://bibletime.info/
+*
+* Copyright 1999-2021 by the BibleTime developers.
+* The BibleTime source code is licensed under the GNU General Public License
+* version 2.0.
+*
+**********/
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+
+
+/**
+  \brief Persistent cache of the texts rendered by BtModuleTextModel.
+
+  The rows of a model are stored in buckets of consecutive rows, one file per
+  bucket in the user cache directory. A bucket is identified by its number and
+  by a context, which describes everything the rendered texts depend on, e.g.
+  the modules and their versions, the display and filter options and the
+  display template. Whenever any of these change, the context changes and the
+  old files are not used any more. The total size of the files is limited, the
+  least recently used files are removed first.
+*/
+namespace RenderedTextCache {
+
+/** The texts of rows by row and role. */
+using Rows = QHash<int, QHash<int, QString>>;
+
+/**
+  \returns the cached rows of the bucket or an empty result if the bucket has
+           not been cached for the context.
+*/
+Rows load(QString const & context, int bucket);
+
+/**
+  \brief Adds the given rows to the cached rows of the bucket.
+  \note Rows and roles already cached are replaced.
+*/
+void save(QString const & context, int bucket, Rows const & rows);
+
+} /* namespace RenderedTextCache */
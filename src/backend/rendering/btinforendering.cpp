@@ -12,6 +12,10 @@
 
 #include "btinforendering.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <list>
 #include <map>
 #include <memory>
 #include <QByteArray>
@@ -21,8 +25,11 @@
 #include <QSharedPointer>
 #include <QStringList>
 #include <Qt>
+#include <QTimer>
+#include <tuple>
 #include <utility>
 #include "../../util/btassert.h"
+#include "../../util/btconnect.h"
 #include "../btglobal.h"
 #include "../config/btconfig.h"
 #include "../drivers/btmodulelist.h"
@@ -57,6 +64,101 @@
 
 namespace {
 
+/**
+  A bounded cache of rendered lexicon entries. Moving the mouse across a text
+  shows the same few Strong's and morphology entries over and over again, each
+  of which would otherwise be looked up and rendered anew. The least recently
+  used entries are dropped first. Since the entries refer to modules by name,
+  the cache is cleared whenever the modules are reloaded.
+*/
+class RenderedEntryCache: public QObject {
+
+public: // types:
+
+    /** Module name, key and the states of the filter options. */
+    using Key = std::tuple<QString, QString, QByteArray>;
+
+public: // methods:
+
+    RenderedEntryCache() {
+        BT_CONNECT(&CSwordBackend::instance(),
+                   &CSwordBackend::sigSwordSetupChanged,
+                   this, &RenderedEntryCache::clear);
+    }
+
+    template <typename Render>
+    QString const & entry(Key key, Render && render) {
+        if (auto const it = m_index.find(key); it != m_index.end()) {
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            return it->second->second;
+        }
+        m_entries.emplace_front(key, render());
+        m_index.emplace(std::move(key), m_entries.begin());
+        if (m_entries.size() > maxEntries) {
+            m_index.erase(m_entries.back().first);
+            m_entries.pop_back();
+        }
+        return m_entries.front().second;
+    }
+
+    void clear() {
+        m_index.clear();
+        m_entries.clear();
+        m_strongsModules.clear();
+    }
+
+    /** \returns the first available Hebrew or Greek Strong's lexicon. */
+    CSwordModuleInfo * firstAvailableStrongsModule(bool const wantHebrew) {
+        auto const it = m_strongsModules.find(wantHebrew);
+        if (it != m_strongsModules.end())
+            return it->second;
+        for (auto * const m : CSwordBackend::instance().moduleList()) {
+            if (m->type() == CSwordLexiconModuleInfo::Lexicon
+                && m->has(wantHebrew
+                          ? CSwordModuleInfo::HebrewDef
+                          : CSwordModuleInfo::GreekDef)
+                && qobject_cast<CSwordLexiconModuleInfo *>(m)->hasStrongsKeys())
+                return m_strongsModules[wantHebrew] = m;
+        }
+        return m_strongsModules[wantHebrew] = nullptr;
+    }
+
+private: // fields:
+
+    static constexpr std::size_t maxEntries = 256u;
+
+    using Entries = std::list<std::pair<Key, QString>>;
+    Entries m_entries; ///< Most recently used first
+    std::map<Key, Entries::iterator> m_index;
+    std::map<bool, CSwordModuleInfo *> m_strongsModules;
+
+};
+
+RenderedEntryCache & renderedEntryCache() {
+    static RenderedEntryCache cache;
+    return cache;
+}
+
+/** \returns the current states of the filter options used for rendering. */
+QByteArray filterOptionStates() {
+    auto const & o = CSwordBackend::instance().filterOptions();
+    QByteArray states;
+    for (int const state : {o.footnotes,
+                            o.strongNumbers,
+                            o.headings,
+                            o.morphTags,
+                            o.lemmas,
+                            o.hebrewPoints,
+                            o.hebrewCantillation,
+                            o.greekAccents,
+                            o.redLetterWords,
+                            o.textualVariants,
+                            o.morphSegmentation,
+                            o.scriptureReferences})
+        states.append(QByteArray::number(state)).append(',');
+    return states;
+}
+
 QString decodeAbbreviation(QString const & data) {
     /// \todo Is "text" correct?
     /* before:
@@ -168,7 +270,9 @@ QString decodeFootnote(QString const & data) {
 
     FilterOptions filterOpts;
     filterOpts.footnotes   = true;
-    CSwordBackend::instance().setFilterOptions(filterOpts);
+    CSwordBackend::FilterOptionsScope const filterOptionsScope(
+                CSwordBackend::instance(),
+                filterOpts);
 
     const QString modulename = list.first();
     const QString swordFootnote = list.last();
@@ -206,30 +310,15 @@ QString decodeFootnote(QString const & data) {
            .arg(module->language()->abbrev(), QObject::tr("Footnote"), text);
 }
 
-CSwordModuleInfo * getFirstAvailableStrongsModule(bool wantHebrew) {
-    for (auto * const m : CSwordBackend::instance().moduleList()) {
-        if (m->type() == CSwordLexiconModuleInfo::Lexicon) {
-            auto lexModule = qobject_cast<CSwordLexiconModuleInfo *>(m);
-            if (wantHebrew
-                && m->has(CSwordModuleInfo::HebrewDef)
-                && lexModule->hasStrongsKeys())
-                return m;
-            if (!wantHebrew
-                && m->has(CSwordModuleInfo::GreekDef)
-                && lexModule->hasStrongsKeys())
-                return m;
-        }
-    }
-    return nullptr;
-}
-
 CSwordModuleInfo * getStrongsModule(bool const wantHebrew) {
     auto * const m =
             btConfig().getDefaultSwordModuleByType(
                 wantHebrew
                 ? QStringLiteral("standardHebrewStrongsLexicon")
                 : QStringLiteral("standardGreekStrongsLexicon"));
-    return m ? m : getFirstAvailableStrongsModule(wantHebrew);
+    return m
+           ? m
+           : renderedEntryCache().firstAvailableStrongsModule(wantHebrew);
 }
 
 QString decodeStrongs(QString const & data) {
@@ -239,10 +328,15 @@ QString decodeStrongs(QString const & data) {
         CSwordModuleInfo * module = getStrongsModule(wantHebrew);
         QString text;
         if (module) {
-            QSharedPointer<CSwordKey> key(module->createKey());
             auto lexModule = qobject_cast<CSwordLexiconModuleInfo *>(module);
-            key->setKey(lexModule->normalizeStrongsKey(strongs));
-            text = key->renderedText();
+            auto normalizedKey = lexModule->normalizeStrongsKey(strongs);
+            text = renderedEntryCache().entry(
+                       {module->name(), normalizedKey, filterOptionStates()},
+                       [module, &normalizedKey] {
+                           QSharedPointer<CSwordKey> key(module->createKey());
+                           key->setKey(normalizedKey);
+                           return key->renderedText();
+                       });
         }
         //if the module could not be found just display an empty lemma info
 
@@ -316,22 +410,30 @@ QString decodeMorph(QString const & data) {
         QString text;
         // BT_ASSERT(module);
         if (module) {
-            QSharedPointer<CSwordKey> key(module->createKey());
-
             // skip H or G (language sign) if we have to skip it
-            const bool isOk = key->setKey(skipFirstChar ? value.mid(1) : value);
-            // BT_ASSERT(isOk);
-            /* try to use the other morph lexicon, because this one failed with
-               the current morph code. */
-            if (!isOk) {
-                /// \todo: what if the module doesn't exist?
-                key->setModule(
-                            btConfig().getDefaultSwordModuleByType(
-                                QStringLiteral("standardHebrewMorphLexicon")));
-                key->setKey(skipFirstChar ? value.mid(1) : value);
-            }
-
-            text = key->renderedText();
+            auto const keyText = skipFirstChar ? value.mid(1) : value;
+            auto * const fallbackModule =
+                    btConfig().getDefaultSwordModuleByType(
+                        QStringLiteral("standardHebrewMorphLexicon"));
+            text = renderedEntryCache().entry(
+                       {fallbackModule
+                        ? module->name() + '|' + fallbackModule->name()
+                        : module->name(),
+                        keyText,
+                        filterOptionStates()},
+                       [module, fallbackModule, &keyText] {
+                           QSharedPointer<CSwordKey> key(module->createKey());
+                           const bool isOk = key->setKey(keyText);
+                           // BT_ASSERT(isOk);
+                           /* try to use the other morph lexicon, because this
+                              one failed with the current morph code. */
+                           if (!isOk) {
+                               /// \todo: what if the module doesn't exist?
+                               key->setModule(fallbackModule);
+                               key->setKey(keyText);
+                           }
+                           return key->renderedText();
+                       });
         }
 
         // if the module wasn't found just display an empty morph info
@@ -369,6 +471,26 @@ QString decodeSwordReference(QString const & data) {
     return {};
 }
 
+std::deque<Rendering::InfoData> & prefetchQueue() {
+    static std::deque<Rendering::InfoData> queue;
+    return queue;
+}
+
+void prefetchNextInfo() {
+    auto & queue = prefetchQueue();
+    if (queue.empty())
+        return;
+    auto const info = std::move(queue.front());
+    queue.pop_front();
+    if (info.first == Rendering::Lemma) {
+        decodeStrongs(info.second);
+    } else {
+        decodeMorph(info.second);
+    }
+    if (!queue.empty())
+        QTimer::singleShot(0, &CSwordBackend::instance(), &prefetchNextInfo);
+}
+
 } // anonymous namespace
 
 namespace Rendering {
@@ -401,6 +523,22 @@ ListInfoData detectInfo(QString const & data) {
 }
 
 
+void prefetchInfo(ListInfoData const & info) {
+    static constexpr std::size_t maxQueued = 64u;
+    auto & queue = prefetchQueue();
+    bool const wasIdle = queue.empty();
+    for (auto const & infoData : info) {
+        if ((infoData.first != Lemma && infoData.first != Morph)
+            || std::find(queue.begin(), queue.end(), infoData) != queue.end())
+            continue;
+        if (queue.size() >= maxQueued) // Favor the most recently shown data
+            queue.pop_front();
+        queue.push_back(infoData);
+    }
+    if (wasIdle && !queue.empty())
+        QTimer::singleShot(0, &CSwordBackend::instance(), &prefetchNextInfo);
+}
+
 QString formatInfo(const ListInfoData & list,  BtConstModuleList const & modules)
 {
     BT_ASSERT(!modules.contains(nullptr) && (modules.size() <= 1 && "not implemented"));
@@ -38,6 +38,15 @@ using ListInfoData = QList<InfoData>;
 /** Parse string for attributes */
 ListInfoData detectInfo(QString const & data);
 
+/**
+  \brief Renders the Strong's and morphology entries of the given data ahead.
+
+  The entries are rendered one by one from the event loop into the cache of
+  rendered lexicon entries, so that they are readily available when they are
+  to be shown later. Other types of data are ignored.
+*/
+void prefetchInfo(ListInfoData const & info);
+
 /** Process list of InfoData and format all data into string */
 QString formatInfo(ListInfoData const & info,
                    BtConstModuleList const & modules);
@@ -185,6 +185,49 @@ QString CTextRendering::renderKeyTree(KeyTree const & tree) const {
     return finishText(t, tree);
 }
 
+CTextRendering::KeyTreeRenderer::KeyTreeRenderer(
+        CTextRendering const & rendering,
+        KeyTree const & tree)
+    : m_rendering(rendering)
+    , m_tree(tree)
+    , m_next(tree.begin())
+{
+    // Same optimization for a single module as in renderKeyTree():
+    BtConstModuleList const modules = collectModules(tree);
+    if (modules.count() == 1)
+        m_key.reset(modules.first()->createKey());
+
+    /* Let finishText() wrap a marker instead of the entries and split its
+       result at the marker: */
+    static QString const marker(QStringLiteral("#KEY_TREE_ENTRIES#"));
+    m_header = m_rendering.finishText(marker, tree);
+    auto const markerPosition = m_header.indexOf(marker);
+    BT_ASSERT(markerPosition >= 0);
+    if (markerPosition >= 0) {
+        m_footer = m_header.mid(markerPosition + marker.size());
+        m_header.truncate(markerPosition);
+    }
+}
+
+CTextRendering::KeyTreeRenderer::~KeyTreeRenderer() = default;
+
+QString CTextRendering::KeyTreeRenderer::renderNext(std::size_t maxItems) {
+    // The options might have been changed by others since the last part:
+    CSwordBackend::instance().setFilterOptions(m_rendering.m_filterOptions);
+
+    QString t;
+    for (; maxItems > 0u && m_next != m_tree.end(); --maxItems, ++m_next) {
+        if (m_key) {
+            m_key->setKey(m_next->key());
+            t.append(m_rendering.renderEntry(*m_next, m_key.get()));
+        } else {
+            t.append(m_rendering.renderEntry(*m_next));
+        }
+        ++m_renderedItems;
+    }
+    return t;
+}
+
 QString CTextRendering::renderKeyRange(
         CSwordVerseKey const & lowerBound,
         CSwordVerseKey const & upperBound,
@@ -275,8 +318,14 @@ QString CTextRendering::renderEntry(KeyTreeItem const & i, CSwordKey * k) const
     BT_ASSERT(key);
 
     CSwordVerseKey * const myVK = dynamic_cast<CSwordVerseKey *>(key);
-    if (myVK)
+    // Parse the key only once, the versifications of the modules are mapped:
+    long firstIndex = -1;
+    if (myVK) {
         myVK->setIntros(true);
+        key->setModule(*modules.begin());
+        if (key->setKey(i.key()) && !myVK->isBoundSet())
+            firstIndex = myVK->index();
+    }
 
     bool const oneModule = modules.size() == 1;
     auto renderedText(oneModule
@@ -287,8 +336,12 @@ QString CTextRendering::renderEntry(KeyTreeItem const & i, CSwordKey * k) const
     for (auto const & modulePtr : modules) {
         BT_ASSERT(modulePtr);
         if (myVK) {
-            key->setModule(*modules.begin());
-            key->setKey(i.key());
+            if (firstIndex >= 0) {
+                myVK->setModuleAndIndex(*modules.begin(), firstIndex);
+            } else {
+                key->setModule(*modules.begin());
+                key->setKey(i.key());
+            }
 
             // this would change key position due to v11n translation
             key->setModule(modulePtr);
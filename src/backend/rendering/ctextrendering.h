@@ -12,7 +12,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <list>
+#include <memory>
 #include <QString>
 #include "../btglobal.h"
 #include "../drivers/btmodulelist.h"
@@ -114,6 +116,49 @@ class CTextRendering {
 
         }; /* class KeyTreeItem */
 
+        /**
+          \brief Renders a key tree part by part.
+
+          The concatenation of header(), all parts returned by renderNext() and
+          footer() equals the text returned by renderKeyTree() for the same
+          tree, but the text of the whole tree is never held at once. Both the
+          rendering and the tree must outlive this object.
+        */
+        class KeyTreeRenderer {
+
+            public: // methods:
+
+                KeyTreeRenderer(CTextRendering const & rendering,
+                                KeyTree const & tree);
+                ~KeyTreeRenderer();
+
+                QString const & header() const noexcept { return m_header; }
+                QString const & footer() const noexcept { return m_footer; }
+
+                bool atEnd() const noexcept { return m_next == m_tree.end(); }
+
+                /** \returns the number of items rendered so far. */
+                std::size_t renderedItems() const noexcept
+                { return m_renderedItems; }
+
+                /**
+                  \returns the text of at most the given number of the next
+                           items of the tree.
+                */
+                QString renderNext(std::size_t maxItems);
+
+            private: // fields:
+
+                CTextRendering const & m_rendering;
+                KeyTree const & m_tree;
+                KeyTree::const_iterator m_next;
+                std::size_t m_renderedItems = 0u;
+                std::unique_ptr<CSwordKey> m_key;
+                QString m_header;
+                QString m_footer;
+
+        }; /* class KeyTreeRenderer */
+
     public: // methods:
 
         CTextRendering(bool addText);
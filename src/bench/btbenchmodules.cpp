@@ -0,0 +1,428 @@
+/*********
+*
+* In the name of the Father, and of the Son, and of the Holy Spirit.
+*
+* This file is part of BibleTime's source code, https://bibletime.info/
+*
+* Copyright 1999-2021 by the BibleTime developers.
+* The BibleTime source code is licensed under the GNU General Public License
+* version 2.0.
+*
+**********/
+
+#include "btbenchmodules.h"
+
+#include <cstdint>
+#include <iterator>
+#include <QByteArray>
+#include <QDir>
+#include <QFile>
+
+// Sword includes:
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wextra-semi"
+#pragma GCC diagnostic ignored "-Wsuggest-override"
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wzero-as-null-pointer-constant"
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wsuggest-destructor-override"
+#endif
+#include <rawgenbook.h>
+#include <rawld.h>
+#include <rawtext.h>
+#include <treekeyidx.h>
+#include <versekey.h>
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+#pragma GCC diagnostic pop
+
+
+namespace BtBenchModules {
+
+char const * const osisBible = "BenchOSIS";
+char const * const thmlBible = "BenchThML";
+char const * const gbfBible = "BenchGBF";
+char const * const teiLexicon = "BenchLexicon";
+char const * const plainBook = "BenchBook";
+
+char const * const firstVerse = "Matt 1:1";
+char const * const lastVerse = "John 21:25";
+
+} // namespace BtBenchModules
+
+namespace {
+
+constexpr int lexiconEntryCount = 500;
+constexpr int bookChapterCount = 40;
+constexpr int bookSectionCount = 10;
+
+char const * const vocabulary[] = {
+    "and", "the", "light", "world", "word", "was", "in", "beginning", "with",
+    "God", "life", "men", "darkness", "shineth", "comprehended", "not", "sent",
+    "witness", "believe", "true", "every", "man", "that", "cometh", "into",
+    "made", "by", "him", "knew", "own", "received", "power", "sons", "flesh",
+    "dwelt", "among", "us", "glory", "grace", "truth", "bare", "cried", "spake",
+    "before", "fulness", "law", "given", "Moses", "seen", "Father", "declared",
+    "record", "Jews", "priests", "Levites", "Jerusalem", "ask", "who", "art",
+    "thou", "confessed", "denied", "Christ", "prophet",
+};
+
+char const * const morphCodes[] = {
+    "N-NSM", "N-GSF", "V-PAI-3S", "V-AAI-3S", "T-NSM", "T-GSF", "CONJ", "PREP",
+    "ADV", "P-1NS", "P-3DSM", "A-NSM",
+};
+
+/** Generates texts from a fixed seed so every run yields the same modules. */
+class TextGenerator {
+
+public: // methods:
+
+    int number(int const bound) noexcept {
+        m_state = m_state * 1103515245u + 12345u;
+        return static_cast<int>((m_state >> 16u)
+                                % static_cast<unsigned>(bound));
+    }
+
+    QByteArray word()
+    { return vocabulary[number(static_cast<int>(std::size(vocabulary)))]; }
+
+    QByteArray words(int const count) {
+        QByteArray r(word());
+        for (int i = 1; i < count; ++i) {
+            r.append(' ');
+            r.append(word());
+        }
+        return r;
+    }
+
+    QByteArray morph()
+    { return morphCodes[number(static_cast<int>(std::size(morphCodes)))]; }
+
+    QByteArray strongs()
+    { return 'G' + QByteArray::number(number(lexiconEntryCount) + 1); }
+
+private: // fields:
+
+    std::uint32_t m_state = 1u;
+
+};
+
+QByteArray osisVerse(TextGenerator & g, int const verse) {
+    QByteArray r;
+    if (verse == 1)
+        r.append("<title>").append(g.words(4)).append("</title>");
+    bool const redLetter = g.number(5) == 0;
+    if (redLetter)
+        r.append("<q who=\"Jesus\" marker=\"\">");
+    for (int i = 0, count = 12 + g.number(20); i < count; ++i) {
+        if (i)
+            r.append(' ');
+        switch (g.number(8)) {
+        case 0: case 1: case 2:
+            r.append("<w lemma=\"strong:").append(g.strongs());
+            r.append("\" morph=\"robinson:").append(g.morph());
+            r.append("\">").append(g.word()).append("</w>");
+            break;
+        case 3:
+            r.append("<transChange type=\"added\">").append(g.word());
+            r.append("</transChange>");
+            break;
+        default:
+            r.append(g.word());
+        }
+    }
+    if (redLetter)
+        r.append("</q>");
+    if (g.number(4) == 0)
+        r.append("<note type=\"x-footnote\">").append(g.words(6))
+         .append("</note>");
+    if (g.number(6) == 0)
+        r.append("<note type=\"crossReference\">"
+                 "<reference osisRef=\"John.3.16\">John 3:16</reference>"
+                 "</note>");
+    return r.append('.');
+}
+
+QByteArray thmlVerse(TextGenerator & g, int const verse) {
+    QByteArray r;
+    if (verse == 1)
+        r.append("<div class=\"sechead\">").append(g.words(4)).append("</div>");
+    bool const redLetter = g.number(5) == 0;
+    if (redLetter)
+        r.append("<font color=\"red\">");
+    for (int i = 0, count = 12 + g.number(20); i < count; ++i) {
+        if (i)
+            r.append(' ');
+        switch (g.number(8)) {
+        case 0: case 1: case 2:
+            r.append(g.word()).append("<sync type=\"Strongs\" value=\"");
+            r.append(g.strongs()).append("\" />");
+            break;
+        case 3:
+            r.append("<i>").append(g.word()).append("</i>");
+            break;
+        default:
+            r.append(g.word());
+        }
+    }
+    if (redLetter)
+        r.append("</font>");
+    if (g.number(4) == 0)
+        r.append("<note place=\"foot\">").append(g.words(6)).append("</note>");
+    if (g.number(6) == 0)
+        r.append("<scripRef passage=\"John 3:16\">John 3:16</scripRef>");
+    return r.append('.');
+}
+
+QByteArray gbfVerse(TextGenerator & g, int const verse) {
+    QByteArray r;
+    if (verse == 1)
+        r.append("<TS>").append(g.words(4)).append("<Ts>");
+    bool const redLetter = g.number(5) == 0;
+    if (redLetter)
+        r.append("<FR>");
+    for (int i = 0, count = 12 + g.number(20); i < count; ++i) {
+        if (i)
+            r.append(' ');
+        switch (g.number(8)) {
+        case 0: case 1: case 2:
+            r.append(g.word()).append("<W").append(g.strongs()).append('>');
+            r.append("<WT").append(g.morph()).append('>');
+            break;
+        case 3:
+            r.append("<FI>").append(g.word()).append("<Fi>");
+            break;
+        default:
+            r.append(g.word());
+        }
+    }
+    if (redLetter)
+        r.append("<Fr>");
+    if (g.number(4) == 0)
+        r.append("<RF>").append(g.words(6)).append("<Rf>");
+    return r.append('.');
+}
+
+QByteArray teiEntry(TextGenerator & g, QByteArray const & key) {
+    QByteArray r("<entryFree n=\"");
+    r.append(key).append("\"><title>").append(key).append("</title><orth>");
+    r.append(g.word()).append("</orth> <pron>").append(g.word());
+    r.append("</pron><lb/>");
+    for (int i = 1, count = 1 + g.number(3); i <= count; ++i) {
+        r.append("<sense n=\"").append(QByteArray::number(i));
+        r.append("\"><def>");
+        r.append(g.words(8 + g.number(16))).append("</def></sense>");
+    }
+    // Numbers referred to like this are linked by CSwordKey::renderedText():
+    for (int i = 0, count = 4 + g.number(28); i < count; ++i) {
+        r.append(i ? ", " : " Compare ");
+        r.append(g.number(2) ? "GREEK" : "HEBREW");
+        r.append(" for 0").append(QByteArray::number(g.number(9000) + 1));
+    }
+    auto const reference = g.strongs();
+    r.append(" See <ref target=\"Strong:").append(reference).append("\">");
+    return r.append(reference).append("</ref>.</entryFree>");
+}
+
+QByteArray plainParagraphs(TextGenerator & g, int const count) {
+    QByteArray r;
+    for (int i = 0; i < count; ++i)
+        r.append(g.words(30 + g.number(40))).append(".\n");
+    return r;
+}
+
+bool createBibles(QDir const & root, TextGenerator & g) {
+    auto const osisPath =
+            root.filePath(QStringLiteral("modules/texts/rawtext/benchosis/"))
+                .toLocal8Bit();
+    auto const thmlPath =
+            root.filePath(QStringLiteral("modules/texts/rawtext/benchthml/"))
+                .toLocal8Bit();
+    auto const gbfPath =
+            root.filePath(QStringLiteral("modules/texts/rawtext/benchgbf/"))
+                .toLocal8Bit();
+    for (auto const * const path : {&osisPath, &thmlPath, &gbfPath})
+        if (sword::RawText::createModule(path->constData()) != 0)
+            return false;
+
+    sword::RawText osis(osisPath.constData());
+    sword::RawText thml(thmlPath.constData());
+    sword::RawText gbf(gbfPath.constData());
+
+    sword::VerseKey key;
+    key.setLowerBound(sword::VerseKey(BtBenchModules::firstVerse));
+    key.setUpperBound(sword::VerseKey(BtBenchModules::lastVerse));
+    auto const write =
+            [&key](sword::SWModule & module, QByteArray const & text) {
+                module.getKey()->setText(key.getText());
+                module.setEntry(text.constData(), text.size());
+            };
+    for (key.setPosition(sword::TOP); !key.popError(); key.increment()) {
+        auto const verse = key.getVerse();
+        write(osis, osisVerse(g, verse));
+        write(thml, thmlVerse(g, verse));
+        write(gbf, gbfVerse(g, verse));
+    }
+    return true;
+}
+
+bool createLexicon(QDir const & root, TextGenerator & g) {
+    static auto const dir =
+            QStringLiteral("modules/lexdict/rawld/benchlexicon");
+    if (!root.mkpath(dir))
+        return false;
+    auto const path =
+            root.filePath(dir + QStringLiteral("/benchlexicon")).toLocal8Bit();
+    if (sword::RawLD::createModule(path.constData()) != 0)
+        return false;
+
+    sword::RawLD lexicon(path.constData());
+    for (int i = 1; i <= lexiconEntryCount; ++i) {
+        auto const key = 'G' + QByteArray::number(i);
+        auto const entry = teiEntry(g, key);
+        lexicon.getKey()->setText(key.constData());
+        lexicon.setEntry(entry.constData(), entry.size());
+    }
+    return true;
+}
+
+bool createBook(QDir const & root, TextGenerator & g) {
+    static auto const dir =
+            QStringLiteral("modules/genbook/rawgenbook/benchbook");
+    if (!root.mkpath(dir))
+        return false;
+    auto const path =
+            root.filePath(dir + QStringLiteral("/benchbook")).toLocal8Bit();
+    if (sword::RawGenBook::createModule(path.constData()) != 0)
+        return false;
+
+    sword::RawGenBook book(path.constData());
+    auto * const key = dynamic_cast<sword::TreeKeyIdx *>(book.getKey());
+    if (!key)
+        return false;
+    auto const write =
+            [&book](QByteArray const & text)
+            { book.setEntry(text.constData(), text.size()); };
+    key->root();
+    for (int chapter = 1; chapter <= bookChapterCount; ++chapter) {
+        if (chapter == 1) {
+            key->appendChild();
+        } else {
+            key->append();
+        }
+        key->setLocalName(
+                ("Chapter " + QByteArray::number(chapter)).constData());
+        key->save();
+        write(plainParagraphs(g, 1));
+
+        for (int section = 1; section <= bookSectionCount; ++section) {
+            if (section == 1) {
+                key->appendChild();
+            } else {
+                key->append();
+            }
+            key->setLocalName(
+                    ("Section " + QByteArray::number(section)).constData());
+            key->save();
+            write(plainParagraphs(g, 3));
+        }
+        key->parent();
+    }
+    return true;
+}
+
+bool writeConfig(QDir const & modsDir,
+                 char const * const name,
+                 QByteArray const & entries)
+{
+    QFile file(modsDir.filePath(QString::fromLatin1(name).toLower()
+                                + QStringLiteral(".conf")));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    auto const data = '[' + QByteArray(name) + "]\n" + entries;
+    return file.write(data) == data.size();
+}
+
+bool writeConfigs(QDir const & root) {
+    QDir const modsDir(root.filePath(QStringLiteral("mods.d")));
+    QByteArray const common("Encoding=UTF-8\nLang=en\nVersion=1.0\n");
+    return writeConfig(
+                modsDir,
+                BtBenchModules::osisBible,
+                common
+                + "DataPath=./modules/texts/rawtext/benchosis/\n"
+                  "ModDrv=RawText\n"
+                  "SourceType=OSIS\n"
+                  "Feature=StrongsNumbers\n"
+                  "GlobalOptionFilter=OSISStrongs\n"
+                  "GlobalOptionFilter=OSISMorph\n"
+                  "GlobalOptionFilter=OSISFootnotes\n"
+                  "GlobalOptionFilter=OSISScripref\n"
+                  "GlobalOptionFilter=OSISHeadings\n"
+                  "GlobalOptionFilter=OSISRedLetterWords\n"
+                  "Description=Synthetic OSIS Bible for benchmarks\n")
+        && writeConfig(
+                modsDir,
+                BtBenchModules::thmlBible,
+                common
+                + "DataPath=./modules/texts/rawtext/benchthml/\n"
+                  "ModDrv=RawText\n"
+                  "SourceType=ThML\n"
+                  "Feature=StrongsNumbers\n"
+                  "GlobalOptionFilter=ThMLStrongs\n"
+                  "GlobalOptionFilter=ThMLFootnotes\n"
+                  "GlobalOptionFilter=ThMLScripref\n"
+                  "GlobalOptionFilter=ThMLHeadings\n"
+                  "Description=Synthetic ThML Bible for benchmarks\n")
+        && writeConfig(
+                modsDir,
+                BtBenchModules::gbfBible,
+                common
+                + "DataPath=./modules/texts/rawtext/benchgbf/\n"
+                  "ModDrv=RawText\n"
+                  "SourceType=GBF\n"
+                  "Feature=StrongsNumbers\n"
+                  "GlobalOptionFilter=GBFStrongs\n"
+                  "GlobalOptionFilter=GBFMorph\n"
+                  "GlobalOptionFilter=GBFFootnotes\n"
+                  "GlobalOptionFilter=GBFHeadings\n"
+                  "GlobalOptionFilter=GBFRedLetterWords\n"
+                  "Description=Synthetic GBF Bible for benchmarks\n")
+        && writeConfig(
+                modsDir,
+                BtBenchModules::teiLexicon,
+                common
+                + "DataPath=./modules/lexdict/rawld/benchlexicon/"
+                  "benchlexicon\n"
+                  "ModDrv=RawLD\n"
+                  "SourceType=TEI\n"
+                  "Feature=GreekDef\n"
+                  "Description=Synthetic TEI lexicon for benchmarks\n")
+        && writeConfig(
+                modsDir,
+                BtBenchModules::plainBook,
+                common
+                + "DataPath=./modules/genbook/rawgenbook/benchbook/benchbook\n"
+                  "ModDrv=RawGenBook\n"
+                  "SourceType=PLAIN\n"
+                  "Description=Synthetic plain text book for benchmarks\n");
+}
+
+} // anonymous namespace
+
+namespace BtBenchModules {
+
+bool create(QString const & path) {
+    QDir const root(path);
+    if (!root.mkpath(QStringLiteral("mods.d")))
+        return false;
+    TextGenerator generator;
+    return createBibles(root, generator)
+           && createLexicon(root, generator)
+           && createBook(root, generator)
+           && writeConfigs(root);
+}
+
+} // namespace BtBenchModules
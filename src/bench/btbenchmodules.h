@@ -0,0 +1,44 @@
+/*********
+*
+* In the name of the Father, and of the Son, and of the Holy Spirit.
+*
+* This file is part of BibleTime's source code, https://bibletime.info/
+*
+* Copyright 1999-2021 by the BibleTime developers.
+* The BibleTime source code is licensed under the GNU General Public License
+* version 2.0.
+*
+**********/
+
+#pragma once
+
+#include <QString>
+
+
+/**
+  \brief A synthetic set of SWORD modules for the benchmarks.
+
+  The texts are generated from a fixed seed, hence every run benchmarks the
+  same data. The Bibles cover the Gospels and carry Strong's numbers referring
+  to the entries of the lexicon.
+*/
+namespace BtBenchModules {
+
+extern char const * const osisBible;
+extern char const * const thmlBible;
+extern char const * const gbfBible;
+extern char const * const teiLexicon;
+extern char const * const plainBook;
+
+/** The first and last verse of the generated Bible text. */
+extern char const * const firstVerse;
+extern char const * const lastVerse;
+
+/**
+  \brief Writes the modules and their configuration to the given directory.
+  \param[in] path The SWORD data directory to write the modules and mods.d to.
+  \returns whether all modules were written successfully.
+*/
+bool create(QString const & path);
+
+} // namespace BtBenchModules
@@ -0,0 +1,131 @@
+/*********
+*
+* In the name of the Father, and of the Son, and of the Holy Spirit.
+*
+* This file is part of BibleTime's source code, https://bibletime.info/
+*
+* Copyright 1999-2021 by the BibleTime developers.
+* The BibleTime source code is licensed under the GNU General Public License
+* version 2.0.
+*
+**********/
+
+#include "btbenchrunner.h"
+
+#include <atomic>
+#include <cstddef>
+#include <QTextStream>
+#include <utility>
+#ifndef __GLIBC__
+#include <cstdlib>
+#include <new>
+#endif
+
+
+namespace {
+
+std::atomic<std::uint64_t> allocations{0u};
+
+inline void countAllocation() noexcept
+{ allocations.fetch_add(1u, std::memory_order_relaxed); }
+
+} // anonymous namespace
+
+#ifdef __GLIBC__
+/* With glibc the allocation functions can be interposed and forwarded to the
+   implementations of the C library, which also counts the allocations done by
+   Qt, Sword and CLucene through malloc(). */
+extern "C" {
+
+void * __libc_malloc(std::size_t size);
+void * __libc_calloc(std::size_t count, std::size_t size);
+void * __libc_realloc(void * ptr, std::size_t size);
+
+void * malloc(std::size_t size) noexcept {
+    countAllocation();
+    return __libc_malloc(size);
+}
+
+void * calloc(std::size_t count, std::size_t size) noexcept {
+    countAllocation();
+    return __libc_calloc(count, size);
+}
+
+void * realloc(void * ptr, std::size_t size) noexcept {
+    countAllocation();
+    return __libc_realloc(ptr, size);
+}
+
+} // extern "C"
+#else
+// Elsewhere only the allocations done through operator new are counted:
+void * operator new(std::size_t size) {
+    countAllocation();
+    if (void * const ptr = std::malloc(size ? size : 1u))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void * operator new[](std::size_t size) { return ::operator new(size); }
+void operator delete(void * ptr) noexcept { std::free(ptr); }
+void operator delete[](void * ptr) noexcept { std::free(ptr); }
+void operator delete(void * ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void * ptr, std::size_t) noexcept { std::free(ptr); }
+#endif
+
+BtBenchRunner::BtBenchRunner(QString filter, int repeat)
+    : m_filter(std::move(filter))
+    , m_repeat(repeat > 0 ? repeat : 1)
+{}
+
+bool BtBenchRunner::isSelected(QString const & name) const
+{ return m_filter.isEmpty() || name.contains(m_filter, Qt::CaseInsensitive); }
+
+void BtBenchRunner::printReport(QTextStream & out) const {
+    int nameWidth = 9;
+    for (auto const & m : m_measurements)
+        nameWidth = qMax(nameWidth, static_cast<int>(m.name.size()));
+
+    out << qSetFieldWidth(nameWidth) << Qt::left << QStringLiteral("Benchmark")
+        << qSetFieldWidth(12) << Qt::right << QStringLiteral("Iterations")
+        << qSetFieldWidth(14) << QStringLiteral("Total ms")
+        << QStringLiteral("us/iteration") << QStringLiteral("allocs/iter")
+        << qSetFieldWidth(0) << '\n';
+    for (auto const & m : m_measurements) {
+        auto const iterations = static_cast<double>(m.iterations);
+        out << qSetFieldWidth(nameWidth) << Qt::left << m.name
+            << qSetFieldWidth(12) << Qt::right << m.iterations
+            << qSetFieldWidth(14) << Qt::fixed << qSetRealNumberPrecision(2)
+            << (static_cast<double>(m.nanoseconds) / 1e6)
+            << (static_cast<double>(m.nanoseconds) / 1e3 / iterations)
+            << qSetRealNumberPrecision(1)
+            << (static_cast<double>(m.allocations) / iterations)
+            << qSetFieldWidth(0) << '\n';
+    }
+    if (!countsMallocAllocations())
+        out << "Note: Only allocations through operator new were counted.\n";
+    out.flush();
+}
+
+std::uint64_t BtBenchRunner::allocationCount() noexcept
+{ return allocations.load(std::memory_order_relaxed); }
+
+bool BtBenchRunner::countsMallocAllocations() noexcept {
+#ifdef __GLIBC__
+    return true;
+#else
+    return false;
+#endif
+}
+
+void BtBenchRunner::record(QString const & name,
+                           int iterations,
+                           qint64 nanoseconds,
+                           std::uint64_t allocationsBefore)
+{
+    m_measurements.push_back(
+                Measurement{name,
+                            iterations,
+                            nanoseconds,
+                            allocationCount() - allocationsBefore});
+}
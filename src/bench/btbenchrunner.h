@@ -0,0 +1,112 @@
+/*********
+*
+* In the name of the Father, and of the Son, and of the Holy Spirit.
+*
+* This file is part of BibleTime's source code, https://bibletime.info/
+*
+* Copyright 1999-2021 by the BibleTime developers.
+* The BibleTime source code is licensed under the GNU General Public License
+* version 2.0.
+*
+**********/
+
+#pragma once
+
+#include <cstdint>
+#include <QElapsedTimer>
+#include <QString>
+#include <QtGlobal>
+#include <vector>
+
+
+class QTextStream;
+
+/**
+  \brief Runs the benchmarks and collects their timings and allocation counts.
+
+  Allocations are counted for the whole process, hence the benchmarks must not
+  be run concurrently with other work.
+*/
+class BtBenchRunner {
+
+public: // types:
+
+    struct Measurement {
+        QString name;
+        int iterations;
+        qint64 nanoseconds;
+        std::uint64_t allocations;
+    };
+
+public: // methods:
+
+    /**
+      \param[in] filter Only benchmarks containing this string are run.
+      \param[in] repeat The factor to multiply the iteration counts with.
+    */
+    BtBenchRunner(QString filter, int repeat);
+
+    /** \returns whether the benchmark with the given name is to be run. */
+    bool isSelected(QString const & name) const;
+
+    /**
+      \brief Runs the given function once untimed and then the given number of
+             times timed.
+    */
+    template <typename Function>
+    void run(QString const & name, int iterations, Function && function) {
+        if (!isSelected(name))
+            return;
+        function(); // Warm up caches
+        iterations *= m_repeat;
+        auto const allocations = allocationCount();
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < iterations; ++i)
+            function();
+        record(name, iterations, timer.nsecsElapsed(), allocations);
+    }
+
+    /**
+      \brief Runs the given function exactly once, for operations which can
+             not be repeated without changing their result.
+    */
+    template <typename Function>
+    void runOnce(QString const & name, Function && function) {
+        if (!isSelected(name))
+            return;
+        auto const allocations = allocationCount();
+        QElapsedTimer timer;
+        timer.start();
+        function();
+        record(name, 1, timer.nsecsElapsed(), allocations);
+    }
+
+    std::vector<Measurement> const & measurements() const noexcept
+    { return m_measurements; }
+
+    void printReport(QTextStream & out) const;
+
+    /** \returns the number of heap allocations made by the process so far. */
+    static std::uint64_t allocationCount() noexcept;
+
+    /**
+      \returns whether allocationCount() includes allocations done through
+               malloc() and not only those done through operator new.
+    */
+    static bool countsMallocAllocations() noexcept;
+
+private: // methods:
+
+    void record(QString const & name,
+                int iterations,
+                qint64 nanoseconds,
+                std::uint64_t allocationsBefore);
+
+private: // fields:
+
+    QString const m_filter;
+    int const m_repeat;
+    std::vector<Measurement> m_measurements;
+
+};
@@ -0,0 +1,29 @@
+/*********
+*
+* In the name of the Father, and of the Son, and of the Holy Spirit.
+*
+* This file is part of BibleTime's source code, https://bibletime.info/
+*
+* Copyright 1999-2021 by the BibleTime developers.
+* The BibleTime source code is licensed under the GNU General Public License
+* version 2.0.
+*
+**********/
+
+#pragma once
+
+#include <QString>
+
+
+/**
+  \brief The regular expression based implementation of
+         BtTextFilter::processText() before it became a single pass.
+
+  Kept as a reference to check that the output of the filter is unchanged and
+  to compare the timings of both implementations.
+*/
+namespace BtBenchTextFilter {
+
+QString processText(QString const & text);
+
+} // namespace BtBenchTextFilter
@@ -0,0 +1,435 @@
+/*********
+*
+* In the name of the Father, and of the Son, and of the Holy Spirit.
+*
+* This file is part of BibleTime's source code, https://bibletime.info/
+*
+* Copyright 1999-2021 by the BibleTime developers.
+* The BibleTime source code is licensed under the GNU General Public License
+* version 2.0.
+*
+**********/
+
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../backend/config/btconfig.h"
+#include "../backend/cswordmodulesearch.h"
+#include "../backend/drivers/cswordlexiconmoduleinfo.h"
+#include "../backend/filters/gbftohtml.h"
+#include "../backend/filters/osistohtml.h"
+#include "../backend/filters/plaintohtml.h"
+#include "../backend/filters/teitohtml.h"
+#include "../backend/filters/thmltohtml.h"
+#include "../backend/keys/cswordversekey.h"
+#include "../backend/managers/cdisplaytemplatemgr.h"
+#include "../backend/managers/cswordbackend.h"
+#include "../backend/rendering/cdisplayrendering.h"
+#include "../frontend/display/modelview/bttextfilter.h"
+#include "../util/directory.h"
+#include "btbenchmodules.h"
+#include "btbenchrunner.h"
+#include "btbenchtextfilter.h"
+
+// Sword includes:
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wextra-semi"
+#pragma GCC diagnostic ignored "-Wsuggest-override"
+#pragma GCC diagnostic ignored "-Wzero-as-null-pointer-constant"
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wsuggest-destructor-override"
+#endif
+#include <listkey.h>
+#include <swbuf.h>
+#include <swfilter.h>
+#include <swkey.h>
+#include <swmgr.h>
+#include <swmodule.h>
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+#pragma GCC diagnostic pop
+
+
+namespace {
+
+char const * const searchQueries[] = {
+    "light",
+    "light AND world",
+    "light OR darkness",
+    "\"the light\"",
+    "wit*",
+    "strong:G1",
+};
+
+char const * const highlightQueries[] = {
+    "light",
+    "light world darkness",
+    "\"the light\"",
+    "wit*",
+};
+
+struct RawEntry {
+    std::unique_ptr<sword::SWKey> key;
+    sword::SWBuf text;
+};
+
+CSwordModuleInfo & findModule(char const * const name) {
+    auto * const module = CSwordBackend::instance().findModuleByName(
+                              QString::fromLatin1(name));
+    if (!module)
+        throw std::runtime_error(std::string("Synthetic module not found: ")
+                                 + name);
+    return *module;
+}
+
+/** \returns up to the given number of non-empty raw entries of the module. */
+std::vector<RawEntry> rawEntries(CSwordModuleInfo const & module,
+                                 std::size_t const maxCount)
+{
+    std::vector<RawEntry> r;
+    auto & m = module.swordModule();
+    for (m.setPosition(sword::TOP);
+         !m.popError() && r.size() < maxCount;
+         m.increment())
+    {
+        sword::SWBuf text(m.getRawEntry());
+        if (text.length() > 0u)
+            r.push_back(RawEntry{std::unique_ptr<sword::SWKey>(
+                                     m.getKey()->clone()),
+                                 std::move(text)});
+    }
+    return r;
+}
+
+void benchmarkIndexing(BtBenchRunner & runner,
+                       std::vector<CSwordModuleInfo *> const & modules)
+{
+    // The home directory is new, hence no module has an index yet:
+    for (auto * const module : modules) {
+        runner.runOnce(QStringLiteral("buildIndex %1").arg(module->name()),
+                       [module]{ module->buildIndex(); });
+        if (!module->hasIndex()) // Needed for searching, even if not timed
+            module->buildIndex();
+    }
+}
+
+void benchmarkSearching(BtBenchRunner & runner,
+                        BtConstModuleList const & bibles)
+{
+    sword::ListKey const scope; // Search in the whole module
+    for (auto const * const module : bibles) {
+        for (auto const * const query : searchQueries) {
+            auto const searchedText = QString::fromLatin1(query);
+            runner.run(QStringLiteral("searchIndexed %1 %2")
+                           .arg(module->name(), searchedText),
+                       20,
+                       [module, &searchedText, &scope]
+                       { module->searchIndexed(searchedText, scope); });
+        }
+    }
+}
+
+void benchmarkRendering(BtBenchRunner & runner,
+                        BtConstModuleList const & bibles,
+                        CSwordModuleInfo const & lexicon,
+                        CSwordModuleInfo const & book)
+{
+    Rendering::CDisplayRendering rendering(btConfig().getDisplayOptions(),
+                                           btConfig().getFilterOptions());
+
+    auto const renderChapter =
+            [&rendering](BtConstModuleList const & modules) {
+                CSwordVerseKey lowerBound(modules.first());
+                lowerBound.setKey("John 1:1");
+                CSwordVerseKey upperBound(modules.first());
+                upperBound.setKey("John 1:51");
+                return rendering.renderKeyRange(lowerBound,
+                                                upperBound,
+                                                modules);
+            };
+    for (auto const * const module : bibles)
+        runner.run(QStringLiteral("renderKeyRange %1 John 1")
+                       .arg(module->name()),
+                   20,
+                   [&renderChapter, module]{ renderChapter({module}); });
+    runner.run(QStringLiteral("renderKeyRange parallel John 1"),
+               10,
+               [&renderChapter, &bibles]{ renderChapter(bibles); });
+
+    auto const renderEntry =
+            [&runner, &rendering](BtConstModuleList const & modules,
+                                  QString const & name,
+                                  QString const & key)
+            {
+                runner.run(QStringLiteral("renderDisplayEntry %1").arg(name),
+                           200,
+                           [&rendering, &modules, &key]
+                           { rendering.renderDisplayEntry(modules, key); });
+            };
+    auto const verse = QStringLiteral("John 3:16");
+    for (auto const * const module : bibles)
+        renderEntry({module}, module->name(), verse);
+    renderEntry(bibles, QStringLiteral("parallel"), verse);
+    renderEntry({&lexicon},
+                lexicon.name(),
+                static_cast<CSwordLexiconModuleInfo const &>(lexicon)
+                    .entries().value(0));
+    renderEntry({&book}, book.name(), QStringLiteral("/Chapter 1/Section 1"));
+
+    // Highlight the searched words in a rendered chapter:
+    auto const chapter = renderChapter({bibles.first()});
+    for (auto const * const query : highlightQueries) {
+        auto const searchedText = QString::fromLatin1(query);
+        runner.run(QStringLiteral("highlightSearchedText %1").arg(searchedText),
+                   50,
+                   [&chapter, &searchedText]{
+                       CSwordModuleSearch::highlightSearchedText(chapter,
+                                                                 searchedText);
+                   });
+    }
+}
+
+void benchmarkFilters(BtBenchRunner & runner,
+                      CSwordModuleInfo const & osisBible,
+                      CSwordModuleInfo const & thmlBible,
+                      CSwordModuleInfo const & gbfBible,
+                      CSwordModuleInfo const & teiLexicon,
+                      CSwordModuleInfo const & plainBook)
+{
+    Filters::OsisToHtml osisFilter;
+    Filters::ThmlToHtml thmlFilter;
+    Filters::GbfToHtml gbfFilter;
+    Filters::TeiToHtml teiFilter;
+    Filters::PlainToHtml plainFilter;
+
+    struct FilterCase {
+        char const * name;
+        sword::SWFilter & filter;
+        CSwordModuleInfo const & module;
+    };
+    FilterCase const cases[] = {
+        {"OsisToHtml", osisFilter, osisBible},
+        {"ThmlToHtml", thmlFilter, thmlBible},
+        {"GbfToHtml", gbfFilter, gbfBible},
+        {"TeiToHtml", teiFilter, teiLexicon},
+        {"PlainToHtml", plainFilter, plainBook},
+    };
+    for (auto const & c : cases) {
+        auto const entries = rawEntries(c.module, 1000u);
+        auto const * const swordModule = &c.module.swordModule();
+        runner.run(QStringLiteral("%1 %2 entries")
+                       .arg(QString::fromLatin1(c.name))
+                       .arg(entries.size()),
+                   10,
+                   [&c, &entries, swordModule]{
+                       for (auto const & entry : entries) {
+                           sword::SWBuf text(entry.text);
+                           c.filter.processText(text,
+                                                entry.key.get(),
+                                                swordModule);
+                       }
+                   });
+    }
+}
+
+void benchmarkTextFilter(BtBenchRunner & runner,
+                         BtConstModuleList const & bibles)
+{
+    Rendering::CDisplayRendering rendering(btConfig().getDisplayOptions(),
+                                           btConfig().getFilterOptions());
+    BtTextFilter filter;
+    for (auto const * const module : bibles) {
+        // The rows of John 1 as rendered by BtModuleTextModel::verseData():
+        QStringList rows;
+        for (int verse = 1; verse <= 51; ++verse)
+            rows.append(
+                    rendering.renderDisplayEntry(
+                        {module},
+                        QStringLiteral("John 1:%1").arg(verse)));
+
+        // The single pass must produce the same output as the old filter:
+        for (int i = 0; i < rows.size(); ++i)
+            if (filter.processText(rows[i])
+                != BtBenchTextFilter::processText(rows[i]))
+                throw std::runtime_error(
+                        QStringLiteral("BtTextFilter output differs from the "
+                                       "old filter in %1 John 1:%2")
+                        .arg(module->name())
+                        .arg(i + 1)
+                        .toStdString());
+
+        runner.run(QStringLiteral("BtTextFilter %1 John 1")
+                       .arg(module->name()),
+                   50,
+                   [&filter, &rows]{
+                       for (auto const & row : rows)
+                           filter.processText(row);
+                   });
+        runner.run(QStringLiteral("BtTextFilter old %1 John 1")
+                       .arg(module->name()),
+                   50,
+                   [&rows]{
+                       for (auto const & row : rows)
+                           BtBenchTextFilter::processText(row);
+                   });
+    }
+}
+
+void runBenchmarks(BtBenchRunner & runner) {
+    namespace M = BtBenchModules;
+    auto & osisBible = findModule(M::osisBible);
+    auto & thmlBible = findModule(M::thmlBible);
+    auto & gbfBible = findModule(M::gbfBible);
+    auto & teiLexicon = findModule(M::teiLexicon);
+    auto & plainBook = findModule(M::plainBook);
+    BtConstModuleList const bibles{&osisBible, &thmlBible, &gbfBible};
+
+    benchmarkIndexing(runner,
+                      {&osisBible, &thmlBible, &gbfBible, &teiLexicon,
+                       &plainBook});
+    benchmarkSearching(runner, bibles);
+    benchmarkRendering(runner, bibles, teiLexicon, plainBook);
+    benchmarkFilters(runner,
+                     osisBible,
+                     thmlBible,
+                     gbfBible,
+                     teiLexicon,
+                     plainBook);
+    benchmarkTextFilter(runner, bibles);
+}
+
+void registerMetaTypes() {
+    qRegisterMetaType<FilterOptions>("FilterOptions");
+    qRegisterMetaType<DisplayOptions>("DisplayOptions");
+
+    qRegisterMetaType<BtConfig::StringMap>("StringMap");
+    qRegisterMetaTypeStreamOperators<BtConfig::StringMap>("StringMap");
+
+    qRegisterMetaType<QList<int> >("QList<int>");
+    qRegisterMetaTypeStreamOperators<QList<int> >("QList<int>");
+}
+
+} // anonymous namespace
+
+
+/*******************************************************************************
+  Benchmark entry point.
+*******************************************************************************/
+
+int main(int argc, char * argv[]) {
+    if (!sword::SWMgr::isICU) {
+        qFatal("SWORD library is required to be built against ICU!");
+        return EXIT_FAILURE;
+    }
+
+    // The backend needs a QApplication for fonts and palettes, but no display:
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    registerMetaTypes();
+
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+                QStringLiteral("Benchmarks the BibleTime backend on a "
+                               "synthetic set of SWORD modules. Must be run "
+                               "from the installation prefix."));
+    parser.addHelpOption();
+    QCommandLineOption const filterOption(
+                QStringLiteral("filter"),
+                QStringLiteral("Only run benchmarks whose name contains "
+                               "<text>."),
+                QStringLiteral("text"));
+    QCommandLineOption const repeatOption(
+                QStringLiteral("repeat"),
+                QStringLiteral("Multiply the iteration counts by <factor>."),
+                QStringLiteral("factor"),
+                QStringLiteral("1"));
+    QCommandLineOption const keepOption(
+                QStringLiteral("keep"),
+                QStringLiteral("Keep the generated modules, indices and "
+                               "configuration."));
+    parser.addOptions({filterOption, repeatOption, keepOption});
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    /* Run in a temporary home directory, so neither the configuration,
+       modules nor indices of the user are used or modified: */
+    QTemporaryDir tempDir;
+    if (!tempDir.isValid()) {
+        err << "Failed to create temporary directory!\n";
+        return EXIT_FAILURE;
+    }
+    tempDir.setAutoRemove(!parser.isSet(keepOption));
+    QDir const baseDir(tempDir.path());
+    auto const homePath = baseDir.filePath(QStringLiteral("home"));
+    auto const swordPath = baseDir.filePath(QStringLiteral("sword"));
+    if (!baseDir.mkpath(homePath) || !baseDir.mkpath(swordPath)) {
+        err << "Failed to create directories in " << baseDir.path() << "!\n";
+        return EXIT_FAILURE;
+    }
+    qputenv("HOME", QFile::encodeName(homePath));
+    qputenv("APPDATA", QFile::encodeName(homePath));
+    QDir::setCurrent(baseDir.path());
+
+    if (!util::directory::initDirectoryCache()) {
+        err << "Error initializing directory cache! bibletime_bench must be "
+               "run from the BibleTime installation prefix.\n";
+        return EXIT_FAILURE;
+    }
+
+    out << "Generating synthetic modules in " << swordPath << Qt::endl;
+    if (!BtBenchModules::create(swordPath)) {
+        err << "Failed to generate the synthetic modules!\n";
+        return EXIT_FAILURE;
+    }
+    // initDirectoryCache() unsets SWORD_PATH, hence set it only afterwards:
+    qputenv("SWORD_PATH", QFile::encodeName(swordPath));
+
+    if (BtConfig::initBtConfig() != BtConfig::INIT_OK) {
+        err << "Failed to initialize the configuration!\n";
+        return EXIT_FAILURE;
+    }
+
+    QString errorMessage;
+    new CDisplayTemplateMgr(errorMessage);
+    if (!errorMessage.isNull()) {
+        err << "Failed to initialize display templates: " << errorMessage
+            << '\n';
+        BtConfig::destroyInstance();
+        return EXIT_FAILURE;
+    }
+
+    int r = EXIT_SUCCESS;
+    BtBenchRunner runner(parser.value(filterOption),
+                         parser.value(repeatOption).toInt());
+    try {
+        CSwordBackend backend;
+        runBenchmarks(runner);
+    } catch (std::exception const & e) {
+        err << "Benchmark failed: " << e.what() << '\n';
+        r = EXIT_FAILURE;
+    }
+    runner.printReport(out);
+
+    delete CDisplayTemplateMgr::instance();
+    BtConfig::destroyInstance();
+    return r;
+}
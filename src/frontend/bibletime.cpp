@@ -26,6 +26,7 @@
 #include <QSplashScreen>
 #include <QSplitter>
 #include <type_traits>
+#include <utility>
 #include "../backend/config/btconfig.h"
 #include "../backend/drivers/cswordmoduleinfo.h"
 #include "../backend/keys/cswordversekey.h"
@@ -40,6 +41,7 @@
 #include "cmdiarea.h"
 #include "display/btfindwidget.h"
 #include "display/btmodelviewreaddisplay.h"
+#include "display/modelview/btquickwidget.h"
 #include "displaywindow/cbiblereadwindow.h"
 #include "displaywindow/cbookreadwindow.h"
 #include "displaywindow/ccommentaryreadwindow.h"
@@ -142,9 +144,15 @@ BibleTime::~BibleTime() {
 
 /** \brief Creates a new presenter in the MDI area according to the type of the
             module. */
-CDisplayWindow* BibleTime::createReadDisplayWindow(
+CDisplayWindow * BibleTime::createReadDisplayWindow(
         QList<CSwordModuleInfo *> modules,
         QString const & key)
+{ return createReadDisplayWindow(std::move(modules), key, false); }
+
+CDisplayWindow * BibleTime::createReadDisplayWindow(
+        QList<CSwordModuleInfo *> modules,
+        QString const & key,
+        bool const deferDisplayView)
 {
     qApp->setOverrideCursor(QCursor(Qt::WaitCursor));
 
@@ -166,13 +174,17 @@ CDisplayWindow* BibleTime::createReadDisplayWindow(
             qFatal("unknown module type");
             std::terminate();
     }
+    if (deferDisplayView)
+        displayWindow->displayWidget()->quickWidget()->setDisplayViewDeferred(
+                    true);
     m_mdi->addSubWindow(displayWindow);
     displayWindow->show();
     displayWindow->lookupKey(key);
 
     /* We have to process pending events here, otherwise displayWindow is not
        fully painted. */
-    qApp->processEvents();
+    if (!deferDisplayView)
+        qApp->processEvents();
     qApp->restoreOverrideCursor();
     return displayWindow;
 }
@@ -266,6 +266,17 @@ private: // methods:
     */
     void refreshDisplayWindows() const;
 
+    /**
+      \brief Creates a new presenter in the MDI area.
+      \param[in] deferDisplayView Whether to defer loading the display view of
+                                  the window until it is made visible with
+                                  CMDIArea::loadVisibleDisplayViews() or
+                                  activated.
+    */
+    CDisplayWindow * createReadDisplayWindow(QList<CSwordModuleInfo *> modules,
+                                             QString const & key,
+                                             bool deferDisplayView);
+
     template <bool goingUp>
     void autoScroll();
 
@@ -28,6 +28,7 @@
 #include <QTimerEvent>
 #include <QToolBar>
 #include <QUrl>
+#include <vector>
 #include "../backend/config/btconfig.h"
 #include "../backend/managers/cswordbackend.h"
 #include "../util/btassert.h"
@@ -496,10 +497,8 @@ void BibleTime::loadProfile(const QString & profileKey) {
     // Save old profile:
     saveProfile();
 
-    // Close all open windows BEFORE switching profile:
-    m_mdi->closeAllSubWindows();
-
-    // Switch profile Activate profile:
+    /* Switch profile. Windows of the old profile are kept open, so that
+       reloadProfile() can reuse the ones with the same works: */
     conf.setCurrentSession(profileKey);
     reloadProfile();
     refreshProfileMenus();
@@ -511,8 +510,13 @@ void BibleTime::reloadProfile() {
     // Disable updates while doing big changes:
     setUpdatesEnabled(false);
 
-    // Close all open windows:
-    m_mdi->closeAllSubWindows();
+    /* Open windows are reused for windows of the session with the same works,
+       all other open windows are closed: */
+    QList<CDisplayWindow *> openWindows;
+    for (auto * const subWindow : m_mdi->subWindowList())
+        if (auto * const w =
+                    qobject_cast<CDisplayWindow *>(subWindow->widget()))
+            openWindows.append(w);
 
     // Reload main window settings:
     auto const sessionConf = btConfig().session();
@@ -567,6 +571,13 @@ void BibleTime::reloadProfile() {
         QList<CSwordModuleInfo *> okModules;
     };
     QMap<QString, WindowLoadStatus> failedWindows;
+    struct WindowToLoad {
+        QString name;
+        BtConfigCore conf;
+        WindowLoadStatus status;
+        CDisplayWindow * reusedWindow;
+    };
+    std::vector<WindowToLoad> windowsToLoad;
     for (auto const & w
          : sessionConf.value<QStringList>(QStringLiteral("windowsList")))
     {
@@ -598,14 +609,40 @@ void BibleTime::reloadProfile() {
         if (!wls.failedModules.isEmpty())
             failedWindows.insert(w, wls);
 
-        // Try to respawn the window:
+        // Try to find an open window with the same works:
+        CDisplayWindow * reusedWindow = nullptr;
+        for (auto it = openWindows.begin(); it != openWindows.end(); ++it) {
+            if ((*it)->modules() == wls.okModules) {
+                reusedWindow = *it;
+                openWindows.erase(it);
+                break;
+            }
+        }
+        windowsToLoad.push_back({w, windowConf, wls, reusedWindow});
+    }
+
+    // Close the windows which are not reused before creating new ones:
+    for (auto * const window : openWindows)
+        window->parentWidget()->close();
+
+    for (auto const & windowToLoad : windowsToLoad) {
+        auto const & windowConf = windowToLoad.conf;
         auto const key = windowConf.value<QString>(QStringLiteral("key"));
-        if (auto * const window = createReadDisplayWindow(wls.okModules, key)) {
+        CDisplayWindow * window = windowToLoad.reusedWindow;
+        if (window) {
+            window->lookupKey(key);
+        } else {
+            // Try to respawn the window:
+            window = createReadDisplayWindow(windowToLoad.status.okModules,
+                                             key,
+                                             true);
+        }
+        if (window) {
             window->applyProfileSettings(windowConf);
             if (windowConf.value<bool>(QStringLiteral("hasFocus"), false))
                 focusWindow = window;
         } else {
-            failedWindows.insert(w, wls);
+            failedWindows.insert(windowToLoad.name, windowToLoad.status);
         }
     }
 
@@ -621,6 +658,9 @@ void BibleTime::reloadProfile() {
     if (focusWindow)
         focusWindow->setFocus();
 
+    // Only load the display views of the windows which can be seen:
+    m_mdi->loadVisibleDisplayViews();
+
     // Re-enable updates and repaint:
     setUpdatesEnabled(true);
     repaint(); /// \bug The main window (except decors) is all black without this (not even hover over toolbar buttons work)
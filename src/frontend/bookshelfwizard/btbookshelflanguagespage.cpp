@@ -12,7 +12,6 @@
 
 #include "btbookshelflanguagespage.h"
 
-#include <memory>
 #include <QApplication>
 #include <QList>
 #include <QListView>
@@ -25,9 +24,7 @@
 #include <set>
 #include "../../backend/btinstallbackend.h"
 #include "../../backend/config/btconfig.h"
-#include "../../backend/drivers/cswordmoduleinfo.h"
 #include "../../backend/language.h"
-#include "../../backend/managers/cswordbackend.h"
 #include "../../util/btconnect.h"
 #include "btbookshelfwizard.h"
 #include "btbookshelfwizardenums.h"
@@ -35,7 +32,7 @@
 // Sword includes:
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wzero-as-null-pointer-constant"
-#include <installmgr.h> // IWYU pragma: keep for BtInstallBackend::source()
+#include <installmgr.h> // IWYU pragma: keep for BtInstallBackend::catalog()
 #pragma GCC diagnostic pop
 
 
@@ -101,12 +98,11 @@ void BtBookshelfLanguagesPage::initializePage() {
 void BtBookshelfLanguagesPage::initializeLanguages() {
     // Get languages from sources:
     std::set<QString> languages;
-    for (auto const & sourceName : btWizard().selectedSources()) {
-        std::unique_ptr<CSwordBackend const> const backend =
-                BtInstallBackend::backend(BtInstallBackend::source(sourceName));
-        for (auto const * module : backend->moduleList())
-            languages.insert(module->language()->translatedName());
-    }
+    for (auto const & sourceName : btWizard().selectedSources())
+        for (auto const & entry
+             : BtInstallBackend::catalog(BtInstallBackend::source(sourceName)))
+            languages.insert(
+                    Language::fromAbbrev(entry.language)->translatedName());
 
     // Update languages model:
     m_model->clear();
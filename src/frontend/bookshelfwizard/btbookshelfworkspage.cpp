@@ -87,6 +87,33 @@ inline bool filter(WizardTaskType const taskType,
     }
 }
 
+/**
+  \brief Same as filter(), but on the catalog entry of a work of a source.
+
+  Used to skip sources without matching works before loading their modules.
+*/
+inline bool filter(WizardTaskType const taskType,
+                   QStringList const & languages,
+                   BtInstallBackend::CatalogEntry const & entry)
+{
+    if (taskType == WizardTaskType::installWorks) {
+        return !CSwordBackend::instance().findModuleByName(entry.name)
+               && languages.contains(
+                   Language::fromAbbrev(entry.language)->translatedName());
+    } else if (taskType == WizardTaskType::updateWorks) {
+        using CSMI = CSwordModuleInfo;
+        using CSV = sword::SWVersion const;
+        CSMI const * const installedModule =
+                CSwordBackend::instance().findModuleByName(entry.name);
+        return installedModule
+               && (CSV(installedModule->config(CSMI::ModuleVersion).toLatin1())
+                   < CSV(entry.version.toLatin1()));
+    } else {
+        BT_ASSERT(taskType == WizardTaskType::removeWorks);
+        return CSwordBackend::instance().findModuleByName(entry.name);
+    }
+}
+
 } // anonymous namespace
 
 BtBookshelfWorksPage::BtBookshelfWorksPage(WizardTaskType iType,
@@ -269,6 +296,20 @@ void BtBookshelfWorksPage::initializePage() {
         for (auto const & sourceName : sources) {
             sword::InstallSource const source =
                     BtInstallBackend::source(sourceName);
+
+            // Only load the modules of sources providing any new matches:
+            auto const catalog = BtInstallBackend::catalog(source);
+            if (std::none_of(
+                    catalog.begin(),
+                    catalog.end(),
+                    [this, &languages, &addedModuleNames](
+                            BtInstallBackend::CatalogEntry const & entry)
+                    {
+                        return !addedModuleNames.contains(entry.name)
+                               && filter(m_taskType, languages, entry);
+                    }))
+                continue;
+
             std::unique_ptr<CSwordBackend const> backend(
                         BtInstallBackend::backend(source));
             bool backendUsed = false;
@@ -12,9 +12,27 @@
 
 #include "btprinter.h"
 
+#include <cstddef>
+#include <QAbstractTextDocumentLayout>
+#include <QFontMetrics>
+#include <QPageLayout>
+#include <QPainter>
+#include <QPalette>
+#include <QPointF>
 #include <QPrintDialog>
 #include <QPrinter>
-#include <QTextEdit>
+#include <QRectF>
+#include <QStringList>
+#include <QTextBlock>
+#include <QTextCharFormat>
+#include <QTextCursor>
+#include <QTextDocument>
+#include <QTextFragment>
+#include <QTextFrame>
+#include <QTextFrameFormat>
+#include <Qt>
+#include <QtGlobal>
+#include <vector>
 #include "../backend/keys/cswordversekey.h"
 #include "../backend/managers/cdisplaytemplatemgr.h"
 #include "../util/btassert.h"
@@ -22,6 +40,82 @@
 
 namespace {
 
+/** The number of entries to lay out at first for every batch of pages. */
+constexpr std::size_t const printBatchSize = 32u;
+
+QString entryAnchorName(std::size_t const entry)
+{ return QStringLiteral("btprintentry%1").arg(entry); }
+
+/**
+  \returns the vertical position of the first text of every entry of the
+           document, as marked by entryAnchorName(), or -1 for entries without
+           any text.
+*/
+std::vector<qreal> entryPositions(QTextDocument const & document,
+                                  std::size_t const entryCount)
+{
+    std::vector<qreal> r(entryCount, -1.0);
+    auto const * const layout = document.documentLayout();
+    for (auto block = document.begin(); block.isValid(); block = block.next()) {
+        for (auto it = block.begin(); !it.atEnd(); ++it) {
+            for (auto const & name : it.fragment().charFormat().anchorNames()) {
+                for (std::size_t i = 0u; i < entryCount; ++i) {
+                    if (r[i] < 0.0 && name == entryAnchorName(i)) {
+                        r[i] = layout->blockBoundingRect(block).top();
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    return r;
+}
+
+/** \returns the character position of the text of the given entry. */
+int entryTextPosition(QTextDocument const & document, std::size_t const entry)
+{
+    auto const name = entryAnchorName(entry);
+    for (auto block = document.begin(); block.isValid(); block = block.next())
+        for (auto it = block.begin(); !it.atEnd(); ++it)
+            if (it.fragment().charFormat().anchorNames().contains(name))
+                return it.fragment().position();
+    return -1;
+}
+
+/**
+  \brief Paints a page of the document and its number like
+         QTextDocument::print() does.
+*/
+void printPage(QPainter & painter,
+               QTextDocument const & document,
+               int const page,
+               int const pageNumber,
+               QPointF const & pageNumberPosition)
+{
+    auto const pageSize = document.pageSize();
+    QRectF const view(0.0,
+                      page * pageSize.height(),
+                      pageSize.width(),
+                      pageSize.height());
+    painter.save();
+    painter.translate(0.0, -view.top());
+    painter.setClipRect(view);
+    QAbstractTextDocumentLayout::PaintContext context;
+    context.clip = view;
+    context.palette.setColor(QPalette::Text, Qt::black);
+    document.documentLayout()->draw(&painter, context);
+
+    painter.setClipping(false);
+    painter.setFont(document.defaultFont());
+    auto const pageString = QString::number(pageNumber);
+    painter.drawText(
+            qRound(pageNumberPosition.x()
+                   - painter.fontMetrics().horizontalAdvance(pageString)),
+            qRound(pageNumberPosition.y() + view.top()),
+            pageString);
+    painter.restore();
+}
+
 inline FilterOptions mangleFilterOptions(FilterOptions fo) {
     fo.footnotes = false;
     fo.scriptureReferences = false;
@@ -41,13 +135,104 @@ BtPrinter::BtPrinter(DisplayOptions const & displayOptions,
 {}
 
 void BtPrinter::printKeyTree(KeyTree const & tree) {
-    QTextEdit htmlPage;
-    htmlPage.setHtml(renderKeyTree(tree));
-
     QPrinter printer;
     QPrintDialog printDialog(&printer);
-    if (printDialog.exec() == QDialog::Accepted)
-        htmlPage.print(&printer);
+    if (printDialog.exec() != QDialog::Accepted)
+        return;
+
+    QPainter painter;
+    if (!painter.begin(&printer))
+        return;
+    auto const pageSize =
+            printer.pageLayout().paintRectPixels(printer.resolution()).size();
+    // Same margins and page numbers as QTextDocument::print():
+    auto const dpiY = printer.logicalDpiY();
+    qreal const margin = 2.0 / 2.54 * dpiY; // 2 cm
+
+    /* The entries are laid out in batches of a few pages. The entry which
+       reaches the last page of a batch and all entries after it are removed
+       from the batch and laid out again at the top of the next batch: */
+    KeyTreeRenderer renderer(*this, tree);
+    QStringList entries;
+    std::size_t batchSize = printBatchSize;
+    int pageNumber = 0;
+    for (;;) {
+        while (static_cast<std::size_t>(entries.size()) < batchSize
+               && !renderer.atEnd())
+            entries.append(renderer.renderNext(1u));
+        if (entries.isEmpty())
+            break;
+
+        QString html(renderer.header());
+        for (int i = 0; i < entries.size(); ++i)
+            html.append(
+                    QStringLiteral("<a name=\"%1\"></a>")
+                        .arg(entryAnchorName(static_cast<std::size_t>(i))))
+                .append(entries.at(i));
+        html.append(renderer.footer());
+
+        QTextDocument document;
+        document.documentLayout()->setPaintDevice(&printer);
+        document.setPageSize(pageSize);
+        document.setHtml(html);
+        html.clear();
+        auto rootFrameFormat = document.rootFrame()->frameFormat();
+        rootFrameFormat.setMargin(margin);
+        document.rootFrame()->setFrameFormat(rootFrameFormat);
+
+        int carriedEntries = 0;
+        if (!renderer.atEnd()) {
+            auto const pageCount = document.pageCount();
+            if (pageCount < 2) { // Not even a full page yet, lay out more
+                batchSize *= 2u;
+                continue;
+            }
+
+            /* Find the last entry which starts before the last page. It
+               usually continues on the last page, hence it is carried over
+               together with all entries after it. This leaves the rest of the
+               page it started on empty, but no entry is split between
+               batches: */
+            auto const lastPageTop = (pageCount - 1) * pageSize.height();
+            auto const positions =
+                    entryPositions(document,
+                                   static_cast<std::size_t>(entries.size()));
+            std::size_t carryFrom = 0u;
+            for (std::size_t i = 0u; i < positions.size(); ++i)
+                if (positions[i] >= 0.0 && positions[i] <= lastPageTop)
+                    carryFrom = i;
+
+            // An entry longer than a page can not be carried over:
+            if (carryFrom > 0u) {
+                auto const position = entryTextPosition(document, carryFrom);
+                if (position >= 0) {
+                    QTextCursor cursor(&document);
+                    cursor.setPosition(position);
+                    cursor.movePosition(QTextCursor::End,
+                                        QTextCursor::KeepAnchor);
+                    cursor.removeSelectedText();
+                    carriedEntries =
+                            entries.size() - static_cast<int>(carryFrom);
+                }
+            }
+        }
+
+        QPointF const pageNumberPosition(
+                pageSize.width() - margin,
+                pageSize.height() - margin
+                + QFontMetrics(document.defaultFont(), &printer).ascent()
+                + 5 * dpiY / 72.0);
+        for (int page = 0; page < document.pageCount(); ++page) {
+            if (pageNumber > 0)
+                printer.newPage();
+            ++pageNumber;
+            printPage(painter, document, page, pageNumber, pageNumberPosition);
+        }
+
+        entries = entries.mid(entries.size() - carriedEntries);
+        batchSize = printBatchSize;
+    }
+    painter.end();
 }
 
 QString BtPrinter::entryLink(KeyTreeItem const & item,
@@ -12,12 +12,15 @@
 
 #include "cexportmanager.h"
 
+#include <cstddef>
 #include <QApplication>
 #include <QClipboard>
+#include <QFile>
 #include <QFileDialog>
 #include <QList>
 #include <QProgressDialog>
 #include <QTextStream>
+#include <utility>
 #include "../backend/drivers/cswordmoduleinfo.h"
 #include "../backend/keys/cswordkey.h"
 #include "../backend/keys/cswordversekey.h"
@@ -40,6 +43,9 @@ using KTI = CTextRendering::KeyTreeItem;
 
 namespace {
 
+/** The number of entries to render before writing them out. */
+constexpr std::size_t const exportChunkSize = 64u;
+
 QTextCodec * getCodec(CExportManager::Format const format) {
     if (format == CExportManager::HTML)
         return QTextCodec::codecForName("UTF-8");
@@ -116,23 +122,15 @@ bool CExportManager::saveKeyList(CSwordModuleSearch::ModuleResultList const & l,
 
     CTextRendering::KeyTree tree; /// \todo Verify that items in tree are properly freed.
 
-    setProgressRange(l.size()); /// \todo check size
     KTI::Settings itemSettings;
     itemSettings.highlight = false;
 
-    for (auto const & keyPtr : l) {
-        if (progressWasCancelled())
-            return false;
+    for (auto const & keyPtr : l)
         tree.emplace_back(QString::fromLocal8Bit(keyPtr->getText()),
                           module,
                           itemSettings);
-        incProgress();
-    }
 
-    QString const text = newRenderer(format, addText)->renderKeyTree(tree);
-    util::tool::savePlainFile(filename, text, getCodec(format));
-    closeProgressDialog();
-    return true;
+    return saveKeyTree(filename, tree, format, addText);
 }
 
 bool CExportManager::saveKeyList(QList<CSwordKey *> const & list,
@@ -151,18 +149,10 @@ bool CExportManager::saveKeyList(QList<CSwordKey *> const & list,
     KTI::Settings itemSettings;
     itemSettings.highlight = false;
 
-    setProgressRange(list.count());
-    for (CSwordKey const * const k : list) {
-        if (progressWasCancelled())
-            return false;
+    for (CSwordKey const * const k : list)
         tree.emplace_back(k->key(), k->module(), itemSettings);
-        incProgress();
-    }
 
-    QString const text = newRenderer(format, addText)->renderKeyTree(tree);
-    util::tool::savePlainFile(filename, text, getCodec(format));
-    closeProgressDialog();
-    return true;
+    return saveKeyTree(filename, tree, format, addText);
 }
 
 namespace {
@@ -212,17 +202,12 @@ bool CExportManager::copyKeyList(CSwordModuleSearch::ModuleResultList const & l,
     KTI::Settings itemSettings;
     itemSettings.highlight = false;
 
-    for (auto const & keyPtr : l) {
-        if (progressWasCancelled())
-            return false;
+    for (auto const & keyPtr : l)
         tree.emplace_back(QString::fromLocal8Bit(keyPtr->getText()),
                           module,
                           itemSettings);
-    }
 
-    copyToClipboard(newRenderer(format, addText)->renderKeyTree(tree));
-    closeProgressDialog();
-    return true;
+    return copyKeyTree(tree, format, addText);
 }
 
 
@@ -237,17 +222,10 @@ bool CExportManager::copyKeyList(QList<CSwordKey *> const & list,
     KTI::Settings itemSettings;
     itemSettings.highlight = false;
 
-    setProgressRange(list.count());
-    for (CSwordKey const * const k : list) {
-        if (progressWasCancelled())
-            return false;
+    for (CSwordKey const * const k : list)
         tree.emplace_back(k->key(), k->module(), itemSettings);
-        incProgress();
-    }
 
-    copyToClipboard(newRenderer(format, addText)->renderKeyTree(tree));
-    closeProgressDialog();
-    return true;
+    return copyKeyTree(tree, format, addText);
 }
 
 namespace {
@@ -428,6 +406,79 @@ std::unique_ptr<CTextRendering> CExportManager::newRenderer(Format const format,
                                            filterOptions)};
 }
 
+bool CExportManager::saveKeyTree(QString const & filename,
+                                 CTextRendering::KeyTree const & tree,
+                                 Format const format,
+                                 bool const addText)
+{
+    struct UserData {
+        CExportManager & manager;
+        CTextRendering::KeyTree const & tree;
+        Format const format;
+        bool const addText;
+        bool completed;
+    } userData{*this, tree, format, addText, false};
+    static auto const writer =
+            +[](QTextStream & out, void * const dataPtr) {
+                auto & data = *static_cast<UserData *>(dataPtr);
+                data.completed = data.manager.renderKeyTree(data.tree,
+                                                            data.format,
+                                                            data.addText,
+                                                            out);
+            };
+    bool const saved = util::tool::savePlainFile(filename,
+                                                 *writer,
+                                                 &userData,
+                                                 getCodec(format));
+    closeProgressDialog();
+    if (!userData.completed) { // Don't leave a partial export behind
+        QFile::remove(filename);
+        return false;
+    }
+    return saved;
+}
+
+bool CExportManager::copyKeyTree(CTextRendering::KeyTree const & tree,
+                                 Format const format,
+                                 bool const addText)
+{
+    QString text;
+    {
+        QTextStream out(&text);
+        if (!renderKeyTree(tree, format, addText, out)) {
+            closeProgressDialog();
+            return false;
+        }
+    }
+    copyToClipboard(std::move(text));
+    closeProgressDialog();
+    return true;
+}
+
+bool CExportManager::renderKeyTree(CTextRendering::KeyTree const & tree,
+                                   Format const format,
+                                   bool const addText,
+                                   QTextStream & out)
+{
+    auto const renderer = newRenderer(format, addText);
+    CTextRendering::KeyTreeRenderer treeRenderer(*renderer, tree);
+
+    setProgressRange(static_cast<int>(tree.size()));
+    out << treeRenderer.header();
+    while (!treeRenderer.atEnd()) {
+        out << treeRenderer.renderNext(exportChunkSize);
+        if (m_progressDialog) {
+            m_progressDialog->setValue(
+                        static_cast<int>(treeRenderer.renderedItems()));
+            qApp->processEvents(); //do not lock the GUI!
+        }
+        if (progressWasCancelled())
+            return false;
+    }
+    out << treeRenderer.footer();
+    return true;
+}
+
 void CExportManager::setProgressRange(int const items) {
     if (!m_progressDialog)
         return;
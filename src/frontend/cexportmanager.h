@@ -19,14 +19,13 @@
 #include "../backend/config/btconfig.h"
 #include "../backend/cswordmodulesearch.h"
 #include "../backend/drivers/btmodulelist.h"
+#include "../backend/rendering/ctextrendering.h"
 
 
 class CSwordKey;
 class CSwordModuleInfo;
 class QProgressDialog;
-namespace Rendering {
-class CTextRendering;
-}
+class QTextStream;
 
 class CExportManager {
 
@@ -110,6 +109,25 @@ private: // methods:
     std::unique_ptr<Rendering::CTextRendering> newRenderer(Format const format,
                                                            bool const addText);
 
+    bool saveKeyTree(QString const & filename,
+                     Rendering::CTextRendering::KeyTree const & tree,
+                     Format const format,
+                     bool const addText);
+
+    bool copyKeyTree(Rendering::CTextRendering::KeyTree const & tree,
+                     Format const format,
+                     bool const addText);
+
+    /**
+      \brief Renders the given tree to the given stream part by part and
+             reports the progress after each part.
+      \returns whether the rendering was not cancelled.
+    */
+    bool renderKeyTree(Rendering::CTextRendering::KeyTree const & tree,
+                       Format const format,
+                       bool const addText,
+                       QTextStream & out);
+
     /** \returns the CSS string used in HTML pages. */
     void setProgressRange(int const items);
 
@@ -31,6 +31,7 @@
 #include "bibletime.h"
 #include "displaywindow/cdisplaywindow.h"
 #include "display/btmodelviewreaddisplay.h"
+#include "display/modelview/btquickwidget.h"
 
 
 namespace {
@@ -157,6 +158,7 @@ void CMDIArea::setMDIArrangementMode( const MDIArrangementMode newArrangementMod
         if (parent == this)
             tab->setTabsClosable(true);
     }
+    QTimer::singleShot(0, this, &CMDIArea::loadVisibleDisplayViews);
 }
 
 void CMDIArea::closeTab(int i) {
@@ -355,6 +357,20 @@ QList<QMdiSubWindow*> CMDIArea::usableWindowList() const {
     return ret;
 }
 
+void CMDIArea::loadVisibleDisplayViews() {
+    auto * const active = activeSubWindow();
+    bool const onlyActive =
+            viewMode() == QMdiArea::TabbedView
+            || (active && active->isMaximized());
+    for (auto * const w : usableWindowList()) {
+        if (w->isMinimized() || (onlyActive && w != active))
+            continue;
+        if (auto * const displayWindow = getDisplayWindow(w))
+            displayWindow->displayWidget()->quickWidget()
+                    ->setDisplayViewDeferred(false);
+    }
+}
+
 void CMDIArea::findNextTextInActiveWindow() { findTextInActiveWindow(false); }
 
 void CMDIArea::findPreviousTextInActiveWindow() { findTextInActiveWindow(true);}
@@ -403,6 +419,11 @@ bool CMDIArea::eventFilter(QObject *o, QEvent *e) {
               lambda connected to subWindowActivated() handle this.
             */
 
+            // Windows which became visible need their display views:
+            if ((newState ^ oldState)
+                & (Qt::WindowMaximized | Qt::WindowMinimized))
+                QTimer::singleShot(0, this, &CMDIArea::loadVisibleDisplayViews);
+
             // Check if subwindow was maximized or un-maximized:
             if ((newState ^ oldState) & Qt::WindowMaximized) {
                 triggerWindowUpdate();
@@ -89,6 +89,13 @@ class CMDIArea: public QMdiArea {
         */
         QList<QMdiSubWindow*> usableWindowList() const;
 
+        /**
+          Loads the deferred display views of all subwindows which can be seen,
+          i.e. of the active subwindow if it is maximized or in tabbed mode and
+          otherwise of all subwindows which are not minimized.
+        */
+        void loadVisibleDisplayViews();
+
         /**
           Show or hide the sub-window min/max buttons.
         */
@@ -47,8 +47,8 @@ BtModelViewReadDisplay::BtModelViewReadDisplay(
         QWidget * const parentWidget)
     : QWidget(parentWidget)
     , m_parentWindow(displayWindow)
+    , m_qmlInterface(new BtQmlInterface(this))
     , m_quickWidget(new BtQuickWidget(this))
-    , m_qmlInterface(m_quickWidget->rootObject()->findChild<BtQmlInterface *>())
     , m_scrollBar(new QScrollBar(this))
 {
     auto * const layout = new QHBoxLayout(this);
@@ -261,8 +261,9 @@ BtModelViewReadDisplay::text(TextPart const part) {
         BT_ASSERT(module->type() == CSwordModuleInfo::Lexicon ||
                   module->type() == CSwordModuleInfo::Commentary ||
                   module->type() == CSwordModuleInfo::GenericBook);
-        FilterOptions filterOptions;
-        CSwordBackend::instance().setFilterOptions(filterOptions);
+        CSwordBackend::FilterOptionsScope const filterOptionsScope(
+                    CSwordBackend::instance(),
+                    FilterOptions());
 
         text = QStringLiteral("%1\n(%2, %3)")
                .arg(key->strippedText(), key->key(), key->module()->name());
@@ -294,8 +295,9 @@ BtModelViewReadDisplay::text(TextPart const part) {
             std::unique_ptr<CSwordKey> key(decodedLink->module->createKey());
             key->setKey(decodedLink->key);
 
-            FilterOptions filterOptions;
-            CSwordBackend::instance().setFilterOptions(filterOptions);
+            CSwordBackend::FilterOptionsScope const filterOptionsScope(
+                        CSwordBackend::instance(),
+                        FilterOptions());
 
             return QStringLiteral("%1\n(%2, %3)")
                    .arg(key->strippedText(), key->key(), key->module()->name());
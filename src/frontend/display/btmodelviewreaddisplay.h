@@ -182,8 +182,8 @@ private: // fields:
 
     QString m_nodeInfo;
 
-    BtQuickWidget * const m_quickWidget;
     BtQmlInterface * const m_qmlInterface;
+    BtQuickWidget * const m_quickWidget;
     QScrollBar * const m_scrollBar;
     int m_scrollBarPosition = 0;
 
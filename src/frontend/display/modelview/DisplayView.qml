@@ -16,9 +16,6 @@ import QtQuick 2.10
 Rectangle {
     id: displayView
 
-    property alias contextMenuIndex: btQmlInterface.contextMenuIndex
-    property alias contextMenuColumn: btQmlInterface.contextMenuColumn
-
     // Mouse movement properties
     property bool mousePressedAndMoving: false
     property int mousePressedX: 0
@@ -41,8 +38,9 @@ Rectangle {
     }
 
     function saveContextMenuIndex(x, y) {
-        contextMenuColumn = Math.floor(x / (listView.width / listView.columns));
-        contextMenuIndex = listView.indexAt(x,y+listView.contentY);
+        btQmlInterface.contextMenuColumn =
+                Math.floor(x / (listView.width / listView.columns));
+        btQmlInterface.contextMenuIndex = listView.indexAt(x,y+listView.contentY);
     }
 
     function deselectCurrentSelection() {
@@ -292,10 +290,11 @@ Rectangle {
     height: 10
     color: btQmlInterface.backgroundColor
 
-    BtQmlInterface {
-        id: btQmlInterface
+    // btQmlInterface is set as context property by BtQuickWidget:
+    Connections {
+        target: btQmlInterface
 
-        onPositionItemOnScreen: {
+        function onPositionItemOnScreen(index) {
             listView.positionViewAtIndex(index, ListView.Contain);
             updateReferenceText();
         }
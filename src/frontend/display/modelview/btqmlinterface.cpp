@@ -25,12 +25,14 @@
 #include "../../../backend/keys/cswordkey.h"
 #include "../../../backend/managers/colormanager.h"
 #include "../../../backend/managers/cswordbackend.h"
+#include "../../../backend/models/btmoduletextfinder.h"
 #include "../../../backend/models/btmoduletextmodel.h"
 #include "../../../backend/rendering/btinforendering.h"
 #include "../../../backend/rendering/cplaintextexportrendering.h"
 #include "../../../backend/rendering/ctextrendering.h"
 #include "../../../backend/rendering/btinforendering.h"
 #include "../../../util/btassert.h"
+#include "../../../util/btconnect.h"
 #include "../../bibletime.h"
 #include "../../cinfodisplay.h"
 #include "../../edittextwizard/btedittextwizard.h"
@@ -39,7 +41,15 @@
 BtQmlInterface::BtQmlInterface(QObject * parent)
     : QObject(parent)
     , m_moduleTextModel(new BtModuleTextModel(this))
-{ m_moduleTextModel->setTextFilter(&m_textFilter); }
+    , m_prefetchInfo(
+          btConfig().value<bool>(QStringLiteral("GUI/prefetchLexiconEntries"),
+                                 true))
+{
+    m_moduleTextModel->setTextFilter(&m_textFilter);
+    // Modules, options and highlighted words are changed by resetting:
+    BT_CONNECT(m_moduleTextModel, &BtModuleTextModel::modelReset,
+               this, &BtQmlInterface::resetFinder);
+}
 
 BtQmlInterface::~BtQmlInterface() = default;
 
@@ -145,13 +155,10 @@ QString BtQmlInterface::getSelectedText() const
 
 QString BtQmlInterface::getRawText(int row, int column) {
     BT_ASSERT(column >= 0 && column <= m_moduleNames.count());
-    CSwordVerseKey key = m_moduleTextModel->indexToVerseKey(row);
     QString moduleName = m_moduleNames.at(column);
     auto * const module =
             CSwordBackend::instance().findModuleByName(moduleName);
-    CSwordVerseKey mKey(module);
-    mKey.setKey(key.key());
-    auto rawText = mKey.rawText();
+    auto rawText = m_moduleTextModel->indexToVerseKey(row, *module).rawText();
 
     /* Since rawText is a complete HTML page at the moment, strip away headers
        and footers of a HTML page, keeping only the contents of <body>: */
@@ -255,6 +262,7 @@ void BtQmlInterface::setRawText(int row, int column, const QString& text) {
     QModelIndex index = m_moduleTextModel->index(row, 0);
     int role = ModuleEntry::Text0Role + column;
     m_moduleTextModel->setData(index, text, role);
+    resetFinder(); // The edited row might contain other words
 }
 
 void BtQmlInterface::cancelMagTimer() {
@@ -329,6 +337,33 @@ void BtQmlInterface::setModules(const QStringList &modules) {
 void BtQmlInterface::changeReference(int i) {
     QString reference = m_moduleTextModel->indexToKeyName(i);
     Q_EMIT updateReference(reference);
+    m_moduleTextModel->prefetchAround(i);
+    if (m_prefetchInfo)
+        prefetchInfo(i);
+}
+
+void BtQmlInterface::prefetchInfo(int const row) {
+    // Typical link: sword://lemmamorph/lemma=H0430||morph=Hncmpa/God
+    static QRegularExpression const rx(
+            QStringLiteral(R"regex(sword://lemmamorph/([^/"]*)/)regex"));
+    Rendering::ListInfoData info;
+    for (int column = 0; column < m_moduleNames.size(); ++column) {
+        auto it = rx.globalMatch(rawText(row, column));
+        while (it.hasNext()) {
+            auto const attributes =
+                    it.next().captured(1).split(QStringLiteral("||"));
+            for (auto const & attribute : attributes) {
+                if (attribute.startsWith(QStringLiteral("lemma="))) {
+                    info.append(qMakePair(Rendering::Lemma,
+                                          attribute.mid(6)));
+                } else if (attribute.startsWith(QStringLiteral("morph="))) {
+                    info.append(qMakePair(Rendering::Morph,
+                                          attribute.mid(6)));
+                }
+            }
+        }
+    }
+    Rendering::prefetchInfo(info);
 }
 
 void BtQmlInterface::dragHandler(int index) {
@@ -395,6 +430,7 @@ bool BtQmlInterface::moduleIsWritable(int column) {
 }
 
 void BtQmlInterface::changeColorTheme() {
+    m_moduleTextModel->clearRenderedRows();
     Q_EMIT backgroundHighlightColorChanged();
     Q_EMIT backgroundColorChanged();
     Q_EMIT foregroundColorChanged();
@@ -489,79 +525,47 @@ void BtQmlInterface::timerEvent(QTimerEvent * const event) {
     }
 }
 
-void BtQmlInterface::findText(bool const backward) {
-    QApplication::setOverrideCursor(Qt::WaitCursor);
-    if (!m_findState)
-        m_findState = FindState{getCurrentModelIndex(), 0};
-
-    if (backward)
-        getPreviousMatchingItem(m_findState->index);
-    else
-        getNextMatchingItem(m_findState->index);
-
-    m_moduleTextModel->setFindState(m_findState);
-    Q_EMIT positionItemOnScreen(m_findState->index);
-    QApplication::restoreOverrideCursor();
-}
-
-int BtQmlInterface::countHighlightsInItem(int index) {
-    QModelIndex mIndex = m_moduleTextModel->index(index);
-    QString text = m_moduleTextModel->data(mIndex, ModuleEntry::Text1Role).toString();
-    int num = text.count(QStringLiteral("\"highlightwords"));
-    return num;
+void BtQmlInterface::resetFinder() {
+    m_finder.reset(); // Cancels any previous search
+    m_pendingFindBackward.reset();
 }
 
-void BtQmlInterface::getNextMatchingItem(int startIndex) {
-    int num = countHighlightsInItem(startIndex);
-    if (num > m_findState->subIndex) { // Found within startIndex item
-        m_findState->index = startIndex;
-        ++m_findState->subIndex;
-        return;
-    }
-
-    if (startIndex >= m_moduleTextModel->rowCount())
-        return;
-
-    int index = startIndex+1;
-    for (int i = 0; i < 1000; ++i) {
-        int num = countHighlightsInItem(index);
-        if (num > 0 ) {
-            m_findState->index = index;
-            m_findState->subIndex = 1;
+void BtQmlInterface::findText(bool const backward) {
+    if (!m_finder) {
+        // The rows are only searched once find is used:
+        if (!m_lastAppliedHighlightWords
+            || m_lastAppliedHighlightWords->words.isEmpty()
+            || m_moduleNames.isEmpty())
             return;
-        }
-        ++index;
+        m_finder = std::make_unique<BtModuleTextFinder>(*m_moduleTextModel);
+        BT_CONNECT(m_finder.get(), &BtModuleTextFinder::rowsSearched,
+                   this, &BtQmlInterface::resolvePendingFind);
     }
-    return;
+    m_pendingFindBackward = backward;
+    resolvePendingFind();
 }
 
-void BtQmlInterface::getPreviousMatchingItem(int startIndex) {
-    int num = countHighlightsInItem(startIndex);
-    if (num > 0 && m_findState->subIndex == 0) {
-        // Found within startIndex item
-        m_findState->index = startIndex;
-        m_findState->subIndex = 1;
-        return;
-    }
-
-    if (startIndex <= 0)
+void BtQmlInterface::resolvePendingFind() {
+    if (!m_pendingFindBackward || !m_finder)
         return;
-
-    int index = startIndex;
-    if (m_findState->subIndex == 0)
-        --index;
-    for (int i = 0; i < 1000; ++i) {
-        int num = countHighlightsInItem(index);
-        if (num > 0 ) {
-            m_findState->index = index;
-            if (m_findState->subIndex == 0)
-                m_findState->subIndex = num;
-            else
-                --m_findState->subIndex;
-            if (m_findState->subIndex != 0)
-                return;
-        }
-        --index;
-    }
-    return;
+    auto const backward = *m_pendingFindBackward;
+    auto const current =
+            m_findState.value_or(FindState{getCurrentModelIndex(), 0});
+    auto const & matches = m_finder->matchMap();
+    auto const found =
+            backward ? matches.previous(current) : matches.next(current);
+
+    /* Rows are searched in ascending order. A following match found is the
+       next one, but without one, the rows not yet searched might contain it.
+       The previous match is known once the current row has been searched: */
+    if (!m_finder->isFinished()
+        && (backward
+            ? current.index >= m_finder->searchedRows()
+            : !found))
+        return; // Wait for more rows to be searched
+
+    m_pendingFindBackward.reset();
+    m_findState = found.value_or(current);
+    m_moduleTextModel->setFindState(m_findState);
+    Q_EMIT positionItemOnScreen(m_findState->index);
 }
@@ -21,6 +21,7 @@
 #include "bttextfilter.h"
 
 
+class BtModuleTextFinder;
 class CSwordKey;
 class CSwordModuleInfo;
 
@@ -97,10 +98,7 @@ public:
     BtQmlInterface(QObject * parent = nullptr);
     ~BtQmlInterface() override;
 
-    int countHighlightsInItem(int index);
     void findText(bool backward);
-    void getNextMatchingItem(int index);
-    void getPreviousMatchingItem(int index);
 
 
     QString const & activeLink() const noexcept { return m_activeLink; }
@@ -181,11 +179,34 @@ private:
     void getFontsFromSettings();
     QString getReferenceFromUrl(const QString& url);
 
+    /**
+      \brief Renders the Mag view contents of the Strong's and morph links of
+             the given row ahead.
+
+      Only the row the view is positioned at is used, lest the rows rendered
+      ahead by the model push the entries actually looked at out of the cache.
+    */
+    void prefetchInfo(int row);
+
+    /**
+      \brief Cancels counting the highlighted words of the rows. Counting is
+             started again by the next findText().
+    */
+    void resetFinder();
+
+    /**
+      \brief Moves to the next or previous match as requested by findText(),
+             once the rows searched so far suffice to determine it.
+    */
+    void resolvePendingFind();
+
 private: // Fields:
 
     bool m_firstHref = false;
     int m_linkTimerId = 0;
     BtModuleTextModel* m_moduleTextModel;
+    /** Whether to prefetch the Mag view contents of Strong's and morph links. */
+    bool const m_prefetchInfo;
     CSwordKey * m_swordKey = nullptr;
 
     QList<QFont> m_fonts;
@@ -200,5 +221,8 @@ private: // Fields:
     int m_contextMenuColumn;
     QString m_activeLink;
     std::optional<FindState> m_findState;
+    std::unique_ptr<BtModuleTextFinder> m_finder;
+    /** Whether a find backward (true) or forward (false) is pending. */
+    std::optional<bool> m_pendingFindBackward;
     std::optional<Selection> m_selection;
 };
@@ -13,13 +13,19 @@
 #include "btquickwidget.h"
 #include "../../bibletime.h"
 
+#include <QCoreApplication>
 #include <QCursor>
+#include <QDebug>
 #include <QGuiApplication>
 #include <QMimeData>
 #include <QMouseEvent>
+#include <QQmlComponent>
+#include <QQmlContext>
 #include <QQmlEngine>
 #include <QQuickItem>
+#include <QShowEvent>
 #include <Qt>
+#include <QUrl>
 #include <QWheelEvent>
 #include "../../../backend/drivers/cswordmoduleinfo.h"
 #include "../../../backend/managers/cswordbackend.h"
@@ -29,15 +35,46 @@
 #include "btqmlinterface.h"
 
 
+namespace {
+
+/**
+  \returns the engine shared by all display windows. The engine caches the
+           compiled components, so the QML files are only loaded once.
+*/
+QQmlEngine * sharedEngine() {
+    static QQmlEngine * const engine =
+            []{
+                auto * const e = new QQmlEngine(QCoreApplication::instance());
+                e->addImportPath(QStringLiteral("qrc:/qml"));
+                return e;
+            }();
+    return engine;
+}
+
+/** \returns the display view component shared by all display windows. */
+QQmlComponent * displayViewComponent() {
+    static QQmlComponent * const component =
+            []{
+                auto * const c =
+                        new QQmlComponent(
+                            sharedEngine(),
+                            QUrl(QStringLiteral("qrc:/qml/DisplayView.qml")),
+                            sharedEngine());
+                if (c->isError())
+                    qWarning() << c->errors();
+                return c;
+            }();
+    return component;
+}
+
+} // anonymous namespace
+
 BtQuickWidget::BtQuickWidget(BtModelViewReadDisplay * readDisplay)
-    : QQuickWidget(readDisplay)
+    : QQuickWidget(sharedEngine(), readDisplay)
     , m_readDisplay(readDisplay)
 {
     setAcceptDrops(true);
 
-    engine()->addImportPath(QStringLiteral("qrc:/qml"));
-    setSource(QUrl(QStringLiteral("qrc:/qml/DisplayView.qml")));
-
     m_scrollTimer.setInterval(100);
     m_scrollTimer.setSingleShot(false);
     connect(&m_scrollTimer, &QTimer::timeout, this,
@@ -57,6 +94,27 @@ BtQuickWidget::BtQuickWidget(BtModelViewReadDisplay * readDisplay)
             });
 }
 
+void BtQuickWidget::loadDisplayView() {
+    // Every window gets its own context with its own BtQmlInterface:
+    auto * const component = displayViewComponent();
+    auto * const context = new QQmlContext(engine()->rootContext(), this);
+    context->setContextProperty(QStringLiteral("btQmlInterface"),
+                                m_readDisplay->qmlInterface());
+    setContent(component->url(), component, component->create(context));
+}
+
+void BtQuickWidget::setDisplayViewDeferred(bool const deferred) {
+    m_displayViewDeferred = deferred;
+    if (!deferred && isVisible() && !rootObject())
+        loadDisplayView();
+}
+
+void BtQuickWidget::showEvent(QShowEvent * const event) {
+    if (!m_displayViewDeferred && !rootObject())
+        loadDisplayView();
+    QQuickWidget::showEvent(event);
+}
+
 void BtQuickWidget::dragEnterEvent(QDragEnterEvent * const e) {
     if (auto const * const btmimedata =
                 qobject_cast<BTMimeData const *>(e->mimeData()))
@@ -15,7 +15,9 @@
 /**
     The BtQuickWidget is a subclass of QQuickWidget. The subclass was
     needed to be able to catch the drop event when a bookmark is dropped
-    on a read window.
+    on a read window. The display view is only loaded when the widget is
+    shown for the first time and loading is not deferred, so windows which
+    were never visible do not render any text.
   */
 
 #include <QTimer>
@@ -41,6 +43,15 @@ public:
 
     CSwordKey* getMouseClickedKey();
 
+    /**
+      \brief Sets whether loading the display view is deferred.
+
+      While deferred, the display view is not loaded even when the widget is
+      shown. When no longer deferred, the view is loaded if the widget is
+      visible.
+    */
+    void setDisplayViewDeferred(bool deferred);
+
 protected:
        void dragMoveEvent(QDragMoveEvent * event) override;
        void dragEnterEvent( QDragEnterEvent* e ) override;
@@ -52,21 +63,25 @@ protected:
        virtual void mouseReleaseEvent(QMouseEvent *event) override;
        virtual void mouseDoubleClickEvent(QMouseEvent *event) override;
        virtual void wheelEvent(QWheelEvent * event) override;
+       void showEvent(QShowEvent * event) override;
 
 private: // methods:
 
    template <typename ... Args>
    void callQml(char const * const method, Args && ... args) {
-       QMetaObject::invokeMethod(rootObject(),
-                                 method,
-                                 Q_ARG(QVariant, args)...);
+       if (auto * const root = rootObject())
+           QMetaObject::invokeMethod(root, method, Q_ARG(QVariant, args)...);
    }
 
+   /** Creates the display view with the BtQmlInterface of the display. */
+   void loadDisplayView();
+
 private:
 
     BtModelViewReadDisplay * m_readDisplay;
 
     QTimer m_scrollTimer;
+    bool m_displayViewDeferred = false;
 
 Q_SIGNALS:
     void referenceDropped(const QString& reference);
@@ -12,113 +12,148 @@
 
 #include "bttextfilter.h"
 
-#include <QDebug>
-#include <QRegularExpression>
-#include <QRegularExpressionMatch>
+#include <optional>
+#include <QLatin1String>
+#include <QStringView>
+#include <utility>
 
 
+/*
+  The filter is a single forward scan over the text, which is split into
+  alternating text and tag parts on the fly. Every tag part reaches from a '<'
+  up to and including the next '>', hence it may only contain a '>' at its end.
+  All parts are appended to one preallocated output string, instead of being
+  copied into a list of strings which is rewritten and joined.
+*/
+
 namespace {
 
-QStringList splitText(QString const & text) {
-    QStringList parts;
-    int from = 0;
-    while (from < text.length()) {
-
-        // Get text before tag
-        int end = text.indexOf('<', from);
-        if (end == -1)
-            end = text.length();
-        parts.append(text.mid(from, end-from));
-        from = end;
-
-        //Get tag text
-        end = text.indexOf('>', from);
-        if (end == -1)
-            end = text.length();
-        parts.append(text.mid(from, end-from+1));
-        from = end+1;
-    }
-    return parts;
+/** \returns whether c is matched by \s of QRegularExpression. */
+inline bool isSpace(QChar const c) noexcept {
+    auto const u = c.unicode();
+    return u == ' ' || (u >= '\t' && u <= '\r');
 }
 
-void fixDoubleBR(QStringList & parts) {
-    static QRegularExpression const rx(R"regex(<br\s*/>)regex");
-    for (int index = 2; index < parts.count(); ++index) {
-        if (parts.at(index).contains(rx) && parts.at(index-2).contains(rx))
-            parts[index] = "";
-    }
+/** \returns whether c is matched by \w of QRegularExpression. */
+inline bool isWordChar(QChar const c) noexcept {
+    auto const u = c.unicode();
+    return (u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z')
+           || (u >= '0' && u <= '9') || u == '_';
 }
 
-// Typical input:  <span class="footnote" note="ESV2011/Luke 11:37/1">
-// Output:         <span class="footnote" note="ESV2011/Luke 11:37/1">1</span>
-
-int rewriteFootnoteAsLink(QStringList & parts, int i, QString const & part) {
-    if (i + 2 >= parts.count())
-        return 1;
-
-    static QRegularExpression const rx(R"regex(note="([^"]*))regex");
-    if (auto const match = rx.match(part); match.hasMatch()) {
-        auto const & footnoteText = parts.at(i + 1);
-        parts[i] =
-            QStringLiteral(
-                R"HTML(<a class="footnote" href="sword://footnote/%1=%2">)HTML")
-            .arg(match.captured(1)).arg(footnoteText);
-        parts[i+1] = QStringLiteral("(%1)").arg(footnoteText);
-        parts[i+2] = QStringLiteral("</a>");
-        return 3;
+inline void append(QString & out, QStringView const part)
+{ out.append(part.data(), static_cast<int>(part.size())); }
+
+/** Removes all <!P> tags, which are not rich text, including any <!P> tags
+    formed by removing others. */
+QString removePTags(QString const & text) {
+    QString r;
+    r.reserve(text.size());
+    for (auto const c : text) {
+        r.append(c);
+        if (c == '>' && r.endsWith(QLatin1String("<!P>")))
+            r.chop(4);
     }
-    return 1;
+    return r;
 }
 
-// Packs attribute part of href into the link
-// Typical input: <a name="Luke11_29" href="sword://Bible/ESV2011/Luke 11:29">
-// Output:        <a href="sword://Bible/ESV2011/Luke 11:29||name=Luke11_29">
+/** \returns whether the tag matches <br\s*\/>. */
+bool isBrTag(QStringView const tag) {
+    if (!tag.endsWith(QLatin1String("/>")))
+        return false;
+    auto i = tag.size() - 2;
+    while (i > 0 && isSpace(tag[i - 1]))
+        --i;
+    return tag.left(i).endsWith(QLatin1String("<br"));
+}
 
-void rewriteHref(QStringList & parts, int i, QString const & part) {
-    static QRegularExpression const rx(
-                R"regex(<a\s+(\w+)="([^"]*)"\s+(\w+)="([^"]*)")regex");
-    if (auto const match = rx.match(part); match.hasMatch())
-        parts[i] =
-            ((match.captured(1) == QStringLiteral("href"))
-             ? QStringLiteral(R"HTML(<a %1="%2||%3=%4" name="crossref">)HTML")
-             : QStringLiteral(R"HTML(<a %3="%4||%1=%2" name="crossref">)HTML"))
-            .arg(match.captured(1),
-                 match.captured(2),
-                 match.captured(3),
-                 match.captured(4));
+/** \returns the value of the first attribute starting with prefix, which is
+    terminated by a quote or, if closingQuote is false, by the end of the tag.
+*/
+std::optional<QStringView> attributeValue(QStringView const tag,
+                                          QLatin1String const prefix,
+                                          bool const closingQuote = true)
+{
+    auto const start = tag.indexOf(prefix);
+    if (start < 0)
+        return {};
+    auto const valueStart = start + prefix.size();
+    auto end = tag.indexOf('"', valueStart);
+    if (end < 0) {
+        if (closingQuote)
+            return {};
+        end = tag.size();
+    }
+    return tag.mid(valueStart, end - valueStart);
+}
+
+/** Matches \s+ at pos. */
+bool skipSpaces(QStringView const tag, qsizetype & pos) {
+    auto const start = pos;
+    while (pos < tag.size() && isSpace(tag[pos]))
+        ++pos;
+    return pos > start;
 }
 
-// Typical input: <span lemma="H07225">God</span>
-// Output: "<a href="sword://lemmamorph/lemma=H0430||/God" style="color: black">"
-int rewriteLemmaOrMorphAsLink(QStringList & parts, int i, QString const & part)
+/** Matches (\w+)="([^"]*)" at pos. */
+bool matchAttribute(QStringView const tag,
+                    qsizetype & pos,
+                    QStringView & name,
+                    QStringView & value)
 {
-    if (i + 2 >= parts.count())
-        return 1;
+    auto const nameStart = pos;
+    while (pos < tag.size() && isWordChar(tag[pos]))
+        ++pos;
+    if (pos == nameStart
+        || !tag.mid(pos).startsWith(QLatin1String(R"HTML(=")HTML")))
+        return false;
+    name = tag.mid(nameStart, pos - nameStart);
+    auto const valueStart = pos + 2;
+    pos = tag.indexOf('"', valueStart);
+    if (pos < 0)
+        return false;
+    value = tag.mid(valueStart, pos - valueStart);
+    ++pos;
+    return true;
+}
 
-    QString value;
+// Packs attribute part of href into the link
+// Typical input: <a name="Luke11_29" href="sword://Bible/ESV2011/Luke 11:29">
+// Output:        <a href="sword://Bible/ESV2011/Luke 11:29||name=Luke11_29">
+
+bool rewriteHref(QString & out, QStringView const tag) {
+    // Finds the first match of <a\s+(\w+)="([^"]*)"\s+(\w+)="([^"]*)":
+    for (auto start = tag.indexOf(QLatin1String("<a"));
+         start >= 0;
+         start = tag.indexOf(QLatin1String("<a"), start + 1))
     {
-        static QRegularExpression const rx(R"regex(lemma="([^"]*)")regex");
-        if (auto const match = rx.match(part); match.hasMatch())
-            value = QStringLiteral("lemma=") + match.captured(1);
-    }{
-        static QRegularExpression const rx(R"regex(morph="([^"]*)")regex");
-        if (auto const match = rx.match(part); match.hasMatch()) {
-            if (value.isEmpty()) {
-                value = QStringLiteral("morph=") + match.captured(1);
-            } else {
-                value = QStringLiteral("%1||morph=%2")
-                        .arg(value, match.captured(1));
-            }
+        auto pos = start + 2;
+        QStringView name1;
+        QStringView value1;
+        QStringView name2;
+        QStringView value2;
+        if (!skipSpaces(tag, pos)
+            || !matchAttribute(tag, pos, name1, value1)
+            || !skipSpaces(tag, pos)
+            || !matchAttribute(tag, pos, name2, value2))
+            continue;
+
+        if (name1 != QStringView(u"href")) {
+            std::swap(name1, name2);
+            std::swap(value1, value2);
         }
+        out.append(QLatin1String("<a "));
+        append(out, name1);
+        out.append(QLatin1String(R"HTML(=")HTML"));
+        append(out, value1);
+        out.append(QLatin1String("||"));
+        append(out, name2);
+        out.append('=');
+        append(out, value2);
+        out.append(QLatin1String(R"HTML(" name="crossref">)HTML"));
+        return true;
     }
-
-    auto const & refText = parts.at(i + 1);
-    parts[i] =
-            QStringLiteral(
-                R"HTM(<a id="lemmamorph" href="sword://lemmamorph/%1/%2">)HTM")
-            .arg(value, refText);
-    parts[i + 2] = QStringLiteral("</a>");
-    return 3;
+    return false;
 }
 
 } // anonymous namespace
@@ -130,32 +165,118 @@ BtTextFilter::~BtTextFilter() = default;
 QString BtTextFilter::processText(const QString &text) {
     if (text.isEmpty())
         return text;
-    QString localText = text;
-    { // Fix !P tag which is not rich text:
-        int index = 0;
-        while ((index = localText.indexOf(QStringLiteral("<!P>"))) >= 0)
-            localText.remove(index,4);
-    }
-    auto parts = splitText(localText);
-    fixDoubleBR(parts);
-
-    for (int i = 0; i < parts.count();) {
-        if (auto const & part = parts.at(i); part.startsWith('<')) { // is tag
-            if (part.contains(QStringLiteral(R"HTML(class="footnote")HTML"))) {
-                i += rewriteFootnoteAsLink(parts, i, part);
-            } else if (part.contains(QStringLiteral(R"HTML(href=")HTML"))) {
-                rewriteHref(parts, i, part);
-                ++i;
-            } else if (part.contains(QStringLiteral(R"HTML(lemma=")HTML"))
-                       || part.contains(QStringLiteral(R"HTML(morph=")HTML")))
-            {
-                i += rewriteLemmaOrMorphAsLink(parts, i, part);
+    QString const source =
+            text.contains(QStringLiteral("<!P>")) ? removePTags(text) : text;
+    QStringView const src(source);
+
+    QString out;
+    out.reserve(source.size() + source.size() / 4);
+
+    qsizetype from = 0;
+    auto const nextText =
+            [&src, &from]() {
+                auto end = src.indexOf('<', from);
+                if (end < 0)
+                    end = src.size();
+                auto const part = src.mid(from, end - from);
+                from = end;
+                return part;
+            };
+
+    /* Returns the next tag part, or an empty part if the tag is to be dropped.
+       Every <br/> directly following another <br/> which was kept is dropped,
+       even if there is text in between. */
+    bool previousTagIsKeptBr = false;
+    auto const nextTag =
+            [&src, &from, &previousTagIsKeptBr]() {
+                auto end = src.indexOf('>', from);
+                end = (end < 0) ? src.size() : end + 1;
+                auto const part = src.mid(from, end - from);
+                from = end;
+                bool const isBr = isBrTag(part);
+                if (isBr && previousTagIsKeptBr) {
+                    previousTagIsKeptBr = false;
+                    return QStringView();
+                }
+                previousTagIsKeptBr = isBr;
+                return part;
+            };
+
+    while (from < src.size()) {
+        append(out, nextText());
+        auto const tag = nextTag();
+        if (tag.isEmpty())
+            continue;
+        bool const hasNextPart = from < src.size();
+
+        if (tag.contains(QLatin1String(R"HTML(class="footnote")HTML"))) {
+            // Typical input:  <span class="footnote" note="ESV2011/Luke 11:37/1">
+            // Output:         <span class="footnote" note="ESV2011/Luke 11:37/1">1</span>
+            if (!hasNextPart) {
+                append(out, tag);
+                continue;
+            }
+            auto const note =
+                    attributeValue(tag,
+                                   QLatin1String(R"HTML(note=")HTML"),
+                                   false);
+            if (!note) {
+                append(out, tag);
+                continue;
+            }
+            auto const footnoteText = nextText();
+            nextTag(); // replaced by </a>
+            if (note->contains('%')) { // Keep the placeholder semantics of arg()
+                out.append(
+                    QStringLiteral(
+                        R"HTML(<a class="footnote" href="sword://footnote/%1=%2">)HTML")
+                    .arg(note->toString()).arg(footnoteText.toString()));
             } else {
-                ++i;
+                out.append(QLatin1String(
+                        R"HTML(<a class="footnote" href="sword://footnote/)HTML"));
+                append(out, *note);
+                out.append('=');
+                append(out, footnoteText);
+                out.append(QLatin1String(R"HTML(">)HTML"));
+            }
+            out.append('(');
+            append(out, footnoteText);
+            out.append(QLatin1String(")</a>"));
+        } else if (tag.contains(QLatin1String(R"HTML(href=")HTML"))) {
+            if (!rewriteHref(out, tag))
+                append(out, tag);
+        } else if (hasNextPart
+                   && (tag.contains(QLatin1String(R"HTML(lemma=")HTML"))
+                       || tag.contains(QLatin1String(R"HTML(morph=")HTML"))))
+        {
+            // Typical input: <span lemma="H07225">God</span>
+            // Output: "<a href="sword://lemmamorph/lemma=H0430||/God" style="color: black">"
+            auto const lemma =
+                    attributeValue(tag, QLatin1String(R"HTML(lemma=")HTML"));
+            auto const morph =
+                    attributeValue(tag, QLatin1String(R"HTML(morph=")HTML"));
+            auto const refText = nextText();
+            nextTag(); // replaced by </a>
+            out.append(QLatin1String(
+                    R"HTM(<a id="lemmamorph" href="sword://lemmamorph/)HTM"));
+            if (lemma) {
+                out.append(QLatin1String("lemma="));
+                append(out, *lemma);
+            }
+            if (morph) {
+                if (lemma)
+                    out.append(QLatin1String("||"));
+                out.append(QLatin1String("morph="));
+                append(out, *morph);
             }
+            out.append('/');
+            append(out, refText);
+            out.append(QLatin1String(R"HTM(">)HTM"));
+            append(out, refText);
+            out.append(QLatin1String("</a>"));
         } else {
-            ++i;
+            append(out, tag);
         }
     }
-    return parts.join(QString());
+    return out;
 }
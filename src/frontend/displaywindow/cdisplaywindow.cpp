@@ -20,6 +20,7 @@
 #include <QMenu>
 #include <QStringList>
 #include <QWidget>
+#include <utility>
 #include "../../backend/config/btconfig.h"
 #include "../../backend/keys/cswordkey.h"
 #include "../../backend/managers/cswordbackend.h"
@@ -98,6 +99,7 @@ void CDisplayWindow::clearMainWindowToolBars() {
 }
 
 void CDisplayWindow::windowActivated() {
+    m_displayWidget->quickWidget()->setDisplayViewDeferred(false);
     clearMainWindowToolBars();
     setupMainWindowToolBars();
 }
@@ -155,14 +157,26 @@ void CDisplayWindow::applyProfileSettings(BtConfigCore const & conf) {
             because they give slightly incorrect results with some window
             managers. Might be related to Qt bug QTBUG-7634.
     */
+    bool const maximized = conf.value<bool>(QStringLiteral("maximized"));
+    // Windows reused on session switches might not be in the normal state:
+    if (!maximized && (w->isMaximized() || w->isMinimized()))
+        w->showNormal();
     const QRect rect = conf.value<QRect>(QStringLiteral("windowRect"));
     w->resize(rect.width(), rect.height());
     w->move(rect.x(), rect.y());
+    auto flags = w->windowFlags() & ~(Qt::WindowStaysOnTopHint
+                                      | Qt::WindowStaysOnBottomHint);
     if (conf.value<bool>(QStringLiteral("staysOnTop"), false))
-        w->setWindowFlags(w->windowFlags() | Qt::WindowStaysOnTopHint);
+        flags |= Qt::WindowStaysOnTopHint;
     if (conf.value<bool>(QStringLiteral("staysOnBottom"), false))
-        w->setWindowFlags(w->windowFlags() | Qt::WindowStaysOnBottomHint);
-    if (conf.value<bool>(QStringLiteral("maximized")))
+        flags |= Qt::WindowStaysOnBottomHint;
+    if (flags != w->windowFlags()) {
+        bool const wasHidden = w->isHidden();
+        w->setWindowFlags(flags); // This hides the window
+        if (!wasHidden)
+            w->show();
+    }
+    if (maximized)
         w->showMaximized();
 
     setUpdatesEnabled(true);
@@ -570,9 +584,11 @@ CSwordKey* CDisplayWindow::getMouseClickedKey() const
 
 /** Refresh the settings of this window. */
 void CDisplayWindow::reload() {
-    // Since all the CSwordModuleInfo pointers are invalidated, we need to
-    // rebuild m_modules based on m_moduleNames, and remove all missing modules:
+    // Since the CSwordModuleInfo pointers of updated works are invalidated, we
+    // need to rebuild m_modules based on m_moduleNames, and remove all missing
+    // modules:
     BT_ASSERT(!m_moduleNames.empty()); // This should otherwise be close()-d
+    auto const oldModules(std::move(m_modules));
     m_modules.clear();
     {
         auto const & backend = CSwordBackend::instance();
@@ -590,7 +606,7 @@ void CDisplayWindow::reload() {
 
     if (m_modules.isEmpty()) {
         close();
-    } else {
+    } else if (m_modules != oldModules) {
         m_displayWidget->reloadModules();
 
         if (auto * const kc = m_keyChooser)
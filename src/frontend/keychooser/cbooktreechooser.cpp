@@ -12,21 +12,21 @@
 
 #include "cbooktreechooser.h"
 
-#include <memory>
 #include <QApplication>
 #include <QCursor>
 #include <QHBoxLayout>
-#include <QStringList>
+#include <QItemSelectionModel>
+#include <QModelIndex>
 #include <Qt>
-#include <QTreeWidgetItemIterator>
-#include <QTreeWidget>
-#include <QTreeWidgetItem>
+#include <QTreeView>
 #include "../../backend/config/btconfig.h"
+#include "../../backend/drivers/btbooktreeindex.h"
 #include "../../backend/drivers/btmodulelist.h"
 #include "../../backend/drivers/cswordbookmoduleinfo.h"
 #include "../../backend/drivers/cswordmoduleinfo.h"
 #include "../../backend/keys/cswordkey.h"
 #include "../../backend/keys/cswordtreekey.h"
+#include "../../backend/models/btbooktreemodel.h"
 #include "../../util/btconnect.h"
 
 
@@ -46,7 +46,9 @@ CBookTreeChooser::CBookTreeChooser(const BtConstModuleList & modules,
     }
 
     //now setup the keychooser widgets
-    m_treeView = new QTreeWidget(this);
+    m_treeModel = new BtBookTreeModel(this);
+    m_treeView = new QTreeView(this);
+    m_treeView->setModel(m_treeModel);
 
     QHBoxLayout* layout = new QHBoxLayout(this);
     layout->setSpacing(0);
@@ -55,7 +57,8 @@ CBookTreeChooser::CBookTreeChooser(const BtConstModuleList & modules,
     m_treeView->setHeaderHidden(true);
 
     //when user selects the item whe must react
-    BT_CONNECT(m_treeView, &QTreeWidget::currentItemChanged,
+    BT_CONNECT(m_treeView->selectionModel(),
+               &QItemSelectionModel::currentChanged,
                this, &CBookTreeChooser::itemActivated);
 
     setKey(key);
@@ -68,21 +71,22 @@ void CBookTreeChooser::setKey(CSwordKey * newKey) {
         m_key = dynamic_cast<CSwordTreeKey*>(newKey);
     }
 
-    const QString key = m_key->key(); //key as text, path
+    auto const * const book = m_treeModel->module();
+    if (!book) // The tree is only set up when shown
+        return;
 
-    QTreeWidgetItem* matching_item = m_treeView->topLevelItem(0);
+    // Keys of the shown book map to nodes directly, others only by their path:
+    auto const node =
+            (m_key->module() == book)
+            ? static_cast<int>(m_key->offset() / 4u)
+            : book->treeIndex().indexOf(m_key->key());
 
-    QTreeWidgetItemIterator it(m_treeView);
-    while (*it) {
-        if ((*it)->text(1) == key) {
-            matching_item = (*it);
-            break;
-        }
-        ++it;
-    }
+    auto index = m_treeModel->indexOfNode(node);
+    if (!index.isValid())
+        index = m_treeModel->index(0, 0);
 
-    m_treeView->setCurrentItem( matching_item );
-    m_treeView->scrollToItem(matching_item);
+    m_treeView->setCurrentIndex(index);
+    m_treeView->scrollTo(index);
 }
 
 void CBookTreeChooser::setModules(const BtConstModuleList &modules,
@@ -101,10 +105,7 @@ void CBookTreeChooser::setModules(const BtConstModuleList &modules,
 
     //if there exists a module and a key, setup the visible tree
     if (refresh && m_modules.count() && m_key) {
-        auto const offset = m_key->offset(); //actually unnecessary, taken care of in setupTree
         setupTree();
-        m_key->setOffset( offset );
-
         adjustFont(); //only when refresh is set.
     }
 }
@@ -129,10 +130,10 @@ void CBookTreeChooser::refreshContent() {
 //pointer.
 
 /** Slot for signal when item is selected by user. */
-void CBookTreeChooser::itemActivated( QTreeWidgetItem* item ) {
-    //Sometimes Qt calls this function with a null pointer.
-    if (item) {
-        m_key->setKey(item->text(1));
+void CBookTreeChooser::itemActivated(QModelIndex const & index) {
+    //Sometimes Qt calls this function with an invalid index.
+    if (index.isValid()) {
+        m_key->setKey(index.data(BtBookTreeModel::KeyRole).toString());
         //tell possible listeners about the change
         Q_EMIT keyChanged(m_key);
     }
@@ -146,7 +147,7 @@ void CBookTreeChooser::updateKey( CSwordKey* key ) {
 /** Reimplementation to handle tree creation on show. */
 void CBookTreeChooser::doShow() {
     show();
-    if (!m_treeView->topLevelItemCount()) {
+    if (!m_treeModel->module() && !m_modules.isEmpty()) {
         QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
         setupTree(); //create the tree structure
         m_treeView->resize(m_treeView->sizeHint());
@@ -154,32 +155,8 @@ void CBookTreeChooser::doShow() {
     }
 }
 
-/** Creates the tree structure in the view. */
+/** Shows the tree of the first module in the view. */
 void CBookTreeChooser::setupTree() {
-    m_treeView->clear();
-
-    auto const offset = m_key->offset();
-
-    m_key->positionToRoot();
-    addKeyChildren(m_key, m_treeView->invisibleRootItem());
-
-    m_key->setOffset( offset );
+    m_treeModel->setModule(m_modules.first());
     setKey(m_key); // the module may have changed
 }
-
-/** Populates tree widget with items. */
-void CBookTreeChooser::addKeyChildren(CSwordTreeKey* key, QTreeWidgetItem* item) {
-    if (key->hasChildren()) {
-        key->positionToFirstChild();
-        do {
-            QStringList columns;
-            columns << key->getLocalNameUnicode() << key->key();
-            QTreeWidgetItem *i = new QTreeWidgetItem(item, columns, QTreeWidgetItem::Type);
-            i->setData(0, Qt::ToolTipRole, key->getLocalNameUnicode());
-            auto const offset = key->offset();
-            addKeyChildren(key, i);
-            key->setOffset(offset);
-        }
-        while (key->positionToNextSibling());
-    }
-}
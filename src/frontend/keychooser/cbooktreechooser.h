@@ -21,10 +21,11 @@
 #include "../../backend/keys/cswordtreekey.h"
 
 
+class BtBookTreeModel;
 class CSwordBookModuleInfo;
 class CSwordKey;
-class QTreeWidget;
-class QTreeWidgetItem;
+class QModelIndex;
+class QTreeView;
 class QWidget;
 
 class CBookTreeChooser final : public CKeyChooser {
@@ -51,19 +52,19 @@ public Q_SLOTS:
 
 private: // methods:
 
-    /** \brief Creates the first level of the tree structure. */
+    /** \brief Shows the tree of the first module in the view. */
     void setupTree();
-    void addKeyChildren(CSwordTreeKey * key, QTreeWidgetItem * item);
     void adjustFont();
 
 private Q_SLOTS:
 
-    void itemActivated(QTreeWidgetItem * item);
+    void itemActivated(QModelIndex const & index);
 
 private: // fields:
 
     QList<CSwordBookModuleInfo const *> m_modules;
     CSwordTreeKey * m_key;
-    QTreeWidget * m_treeView;
+    BtBookTreeModel * m_treeModel;
+    QTreeView * m_treeView;
 
 }; /* class CBookTreeChooser */
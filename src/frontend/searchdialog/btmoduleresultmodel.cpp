@@ -0,0 +1,282 @@
+/*********
+*
+* In the name of the Father, and of the Son, and of the Holy Spirit.
+*
+* This file is part of BibleTime's source code, https://bibletime.info/
+*
+* Copyright 1999-2021 by the BibleTime developers.
+* The BibleTime source code is licensed under the GNU General Public License
+* version 2.0.
+*
+**********/
+
+#include "btmoduleresultmodel.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <QIcon>
+#include <QModelIndexList>
+#include <utility>
+#include "../../backend/drivers/cswordmoduleinfo.h"
+#include "../../util/btassert.h"
+#include "../../util/tool.h"
+#include "btsearchresultarea.h"
+
+
+namespace Search {
+
+struct BtModuleResultModel::ModuleEntry {
+    std::size_t searchPosition;
+    CSwordModuleInfo const * module;
+    CSwordModuleSearch::ModuleResultList results;
+
+    /** The Strong's translations, null until first fetched. */
+    std::unique_ptr<StrongsResultList> strongs;
+};
+
+BtModuleResultModel::BtModuleResultModel(QObject * parent)
+    : QAbstractItemModel(parent)
+{}
+
+BtModuleResultModel::~BtModuleResultModel() noexcept = default;
+
+void BtModuleResultModel::setResults(CSwordModuleSearch::Results const & results,
+                                     QString strongsNumber)
+{
+    beginResetModel();
+    m_entries.clear();
+    m_entries.reserve(results.size());
+    for (auto const & result : results)
+        m_entries.emplace_back(new ModuleEntry{m_entries.size(),
+                                               result.module,
+                                               result.results,
+                                               {}});
+    m_strongsNumber = std::move(strongsNumber);
+    sortEntries();
+    endResetModel();
+}
+
+void BtModuleResultModel::clear() {
+    beginResetModel();
+    m_entries.clear();
+    m_strongsNumber.clear();
+    endResetModel();
+}
+
+CSwordModuleInfo const * BtModuleResultModel::module(QModelIndex const & index)
+        const
+{
+    auto const * const e = entry(index);
+    return e ? e->module : nullptr;
+}
+
+CSwordModuleSearch::ModuleResultList const & BtModuleResultModel::results(
+        QModelIndex const & index) const
+{
+    static CSwordModuleSearch::ModuleResultList const noResults;
+    auto const * const e = entry(index);
+    return e ? e->results : noResults;
+}
+
+QStringList BtModuleResultModel::strongsKeyNames(QModelIndex const & index)
+        const
+{
+    if (!isStrongsIndex(index))
+        return {};
+    auto const * const e = entry(index);
+    BT_ASSERT(e->strongs);
+    return e->strongs->at(index.row()).getKeyList();
+}
+
+QModelIndex BtModuleResultModel::index(int row,
+                                       int column,
+                                       QModelIndex const & parent) const
+{
+    if (row < 0 || column < 0 || column >= ColumnCount)
+        return {};
+    if (!parent.isValid()) {
+        if (static_cast<std::size_t>(row) >= m_entries.size())
+            return {};
+        return createIndex(row, column);
+    }
+    if (isStrongsIndex(parent))
+        return {};
+    auto * const e = m_entries[static_cast<std::size_t>(parent.row())].get();
+    if (!e->strongs || row >= e->strongs->count())
+        return {};
+    return createIndex(row, column, e);
+}
+
+QModelIndex BtModuleResultModel::parent(QModelIndex const & index) const {
+    if (!isStrongsIndex(index))
+        return {};
+    auto const * const e = static_cast<ModuleEntry *>(index.internalPointer());
+    auto const it =
+            std::find_if(m_entries.begin(),
+                         m_entries.end(),
+                         [e](auto const & p) { return p.get() == e; });
+    BT_ASSERT(it != m_entries.end());
+    return createIndex(static_cast<int>(it - m_entries.begin()), 0);
+}
+
+int BtModuleResultModel::rowCount(QModelIndex const & parent) const {
+    if (!parent.isValid())
+        return static_cast<int>(m_entries.size());
+    if (isStrongsIndex(parent) || parent.column() != 0)
+        return 0;
+    auto const & e = *m_entries[static_cast<std::size_t>(parent.row())];
+    return e.strongs ? e.strongs->count() : 0;
+}
+
+int BtModuleResultModel::columnCount(QModelIndex const &) const
+{ return ColumnCount; }
+
+bool BtModuleResultModel::hasChildren(QModelIndex const & parent) const {
+    if (!parent.isValid())
+        return !m_entries.empty();
+    if (isStrongsIndex(parent)
+        || parent.column() != 0
+        || m_strongsNumber.isEmpty())
+        return false;
+    auto const & e = *m_entries[static_cast<std::size_t>(parent.row())];
+    return !e.strongs || !e.strongs->isEmpty();
+}
+
+bool BtModuleResultModel::canFetchMore(QModelIndex const & parent) const {
+    if (!parent.isValid()
+        || isStrongsIndex(parent)
+        || m_strongsNumber.isEmpty())
+        return false;
+    return !m_entries[static_cast<std::size_t>(parent.row())]->strongs;
+}
+
+void BtModuleResultModel::fetchMore(QModelIndex const & parent) {
+    if (!canFetchMore(parent))
+        return;
+    auto & e = *m_entries[static_cast<std::size_t>(parent.row())];
+    std::unique_ptr<StrongsResultList> strongs(
+            new StrongsResultList(e.module, e.results, m_strongsNumber));
+    if (strongs->isEmpty()) {
+        e.strongs = std::move(strongs);
+        return;
+    }
+    beginInsertRows(parent.sibling(parent.row(), 0), 0, strongs->count() - 1);
+    e.strongs = std::move(strongs);
+    endInsertRows();
+}
+
+QVariant BtModuleResultModel::data(QModelIndex const & index, int role) const
+{
+    auto const * const e = entry(index);
+    if (!e)
+        return {};
+
+    if (isStrongsIndex(index)) {
+        if (role != Qt::DisplayRole)
+            return {};
+        auto const & strongsResult = e->strongs->at(index.row());
+        if (index.column() == ModuleColumn)
+            return strongsResult.keyText();
+        return QString::number(strongsResult.keyCount());
+    }
+
+    switch (role) {
+    case Qt::DisplayRole:
+        if (index.column() == ModuleColumn)
+            return e->module->name();
+        return QString::number(e->results.size());
+    case Qt::DecorationRole:
+        if (index.column() == ModuleColumn)
+            return util::tool::getIconForModule(e->module);
+        return {};
+    default:
+        return {};
+    }
+}
+
+QVariant BtModuleResultModel::headerData(int section,
+                                         Qt::Orientation orientation,
+                                         int role) const
+{
+    if (role != Qt::DisplayRole || orientation != Qt::Horizontal)
+        return {};
+    switch (section) {
+    case ModuleColumn: return tr("Work");
+    case HitsColumn: return tr("Hits");
+    default: return {};
+    }
+}
+
+void BtModuleResultModel::sort(int column, Qt::SortOrder order) {
+    if (column >= ColumnCount)
+        return;
+
+    Q_EMIT layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+    m_sortColumn = column;
+    m_sortOrder = order;
+
+    /* Only the top level rows are sorted. The indexes of the Strong's
+       translations refer to their module entry, hence they remain valid. */
+    QModelIndexList oldIndexes;
+    std::vector<ModuleEntry const *> oldEntries;
+    for (auto const & oldIndex : persistentIndexList()) {
+        if (isStrongsIndex(oldIndex))
+            continue;
+        oldIndexes.append(oldIndex);
+        oldEntries.push_back(entry(oldIndex));
+    }
+
+    sortEntries();
+
+    QModelIndexList newIndexes;
+    newIndexes.reserve(oldIndexes.size());
+    for (std::size_t i = 0u; i < oldEntries.size(); ++i) {
+        auto const it =
+                std::find_if(m_entries.begin(),
+                             m_entries.end(),
+                             [e = oldEntries[i]](auto const & p)
+                             { return p.get() == e; });
+        newIndexes.append(
+                createIndex(static_cast<int>(it - m_entries.begin()),
+                            oldIndexes.at(static_cast<int>(i)).column()));
+    }
+    changePersistentIndexList(oldIndexes, newIndexes);
+    Q_EMIT layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+}
+
+BtModuleResultModel::ModuleEntry const * BtModuleResultModel::entry(
+        QModelIndex const & index) const noexcept
+{
+    if (!index.isValid())
+        return nullptr;
+    if (auto const * const e =
+                static_cast<ModuleEntry const *>(index.internalPointer()))
+        return e;
+    if (static_cast<std::size_t>(index.row()) >= m_entries.size())
+        return nullptr;
+    return m_entries[static_cast<std::size_t>(index.row())].get();
+}
+
+void BtModuleResultModel::sortEntries() {
+    auto const lessThan =
+            [this](std::unique_ptr<ModuleEntry> const & a,
+                   std::unique_ptr<ModuleEntry> const & b)
+            {
+                if (m_sortColumn < 0) // The order the modules were searched in
+                    return a->searchPosition < b->searchPosition;
+                if (m_sortColumn == HitsColumn)
+                    return a->results.size() < b->results.size();
+                return a->module->name().compare(b->module->name(),
+                                                 Qt::CaseInsensitive) < 0;
+            };
+    if (m_sortOrder == Qt::AscendingOrder) {
+        std::stable_sort(m_entries.begin(), m_entries.end(), lessThan);
+    } else {
+        std::stable_sort(m_entries.begin(),
+                         m_entries.end(),
+                         [&lessThan](auto const & a, auto const & b)
+                         { return lessThan(b, a); });
+    }
+}
+
+} // namespace Search
@@ -0,0 +1,118 @@
+/*********
+*
+* In the name of the Father, and of the Son, and of the Holy Spirit.
+*
+* This file is part of BibleTime's source code, https://bibletime.info/
+*
+* Copyright 1999-2021 by the BibleTime developers.
+* The BibleTime source code is licensed under the GNU General Public License
+* version 2.0.
+*
+**********/
+
+#pragma once
+
+#include <QAbstractItemModel>
+
+#include <memory>
+#include <QModelIndex>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <Qt>
+#include <QVariant>
+#include <vector>
+#include "../../backend/cswordmodulesearch.h"
+
+
+class CSwordModuleInfo;
+
+namespace Search {
+
+class StrongsResultList;
+
+/**
+  A tree model grouping the search results by module. The top level rows hold
+  the searched modules and their hit counts. For Strong's searches each module
+  row has the different translations of the searched Strong's number as its
+  children. These are only parsed from the hits when a module row is expanded,
+  since this requires rendering every hit of the module.
+*/
+class BtModuleResultModel: public QAbstractItemModel {
+
+    Q_OBJECT
+
+public: // types:
+
+    enum Column {
+        ModuleColumn = 0,
+        HitsColumn = 1,
+        ColumnCount
+    };
+
+public: // methods:
+
+    BtModuleResultModel(QObject * parent = nullptr);
+    ~BtModuleResultModel() noexcept override;
+
+    /**
+      \brief Sets the results to display.
+      \param[in] results The search results.
+      \param[in] strongsNumber The Strong's number searched for or an empty
+                               string if this was not a Strong's search.
+    */
+    void setResults(CSwordModuleSearch::Results const & results,
+                    QString strongsNumber);
+
+    /** \brief Removes all results from this model. */
+    void clear();
+
+    /** \returns the module of the given index or of its parent. */
+    CSwordModuleInfo const * module(QModelIndex const & index) const;
+
+    /** \returns the results of the module at or above the given index. */
+    CSwordModuleSearch::ModuleResultList const & results(
+            QModelIndex const & index) const;
+
+    /** \returns whether the given index refers to a Strong's translation. */
+    bool isStrongsIndex(QModelIndex const & index) const noexcept
+    { return index.isValid() && index.internalPointer(); }
+
+    /** \returns the keys of the Strong's translation at the given index. */
+    QStringList strongsKeyNames(QModelIndex const & index) const;
+
+    // Virtual methods implemented from QAbstractItemModel:
+    QModelIndex index(int row,
+                      int column,
+                      QModelIndex const & parent = QModelIndex()) const override;
+    QModelIndex parent(QModelIndex const & index) const override;
+    int rowCount(QModelIndex const & parent = QModelIndex()) const override;
+    int columnCount(QModelIndex const & parent = QModelIndex()) const override;
+    bool hasChildren(QModelIndex const & parent = QModelIndex()) const override;
+    bool canFetchMore(QModelIndex const & parent) const override;
+    void fetchMore(QModelIndex const & parent) override;
+    QVariant data(QModelIndex const & index, int role) const override;
+    QVariant headerData(int section,
+                        Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+private: // types:
+
+    struct ModuleEntry;
+
+private: // methods:
+
+    ModuleEntry const * entry(QModelIndex const & index) const noexcept;
+    void sortEntries();
+
+private: // fields:
+
+    std::vector<std::unique_ptr<ModuleEntry>> m_entries;
+    QString m_strongsNumber;
+    int m_sortColumn = -1;
+    Qt::SortOrder m_sortOrder = Qt::AscendingOrder;
+
+};
+
+} // namespace Search
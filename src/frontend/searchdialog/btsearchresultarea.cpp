@@ -137,10 +137,10 @@ void BtSearchResultArea::setSearchResult(QString searchedText,
     m_results = std::move(results);
 
     // Populate listbox:
-    m_moduleListBox->setupTree(m_results, searchedText);
+    m_moduleListBox->setupTree(m_results, m_searchedText);
 
     // Pre-select the first module in the list:
-    m_moduleListBox->setCurrentItem(m_moduleListBox->topLevelItem(0), 0);
+    m_moduleListBox->selectFirstModule();
 }
 
 void BtSearchResultArea::reset() {
@@ -157,7 +157,7 @@ void BtSearchResultArea::clearPreview() {
 void BtSearchResultArea::updatePreview(const QString& key) {
     using namespace Rendering;
 
-    CSwordModuleInfo* module = m_moduleListBox->activeModule();
+    auto const * const module = m_moduleListBox->activeModule();
     if ( module ) {
         QString text;
         CDisplayRendering render;
@@ -0,0 +1,169 @@
+/*********
+*
+* In the name of the Father, and of the Son, and of the Holy Spirit.
+*
+* This file is part of BibleTime's source code, https://bibletime.info/
+*
+* Copyright 1999-2021 by the BibleTime developers.
+* The BibleTime source code is licensed under the GNU General Public License
+* version 2.0.
+*
+**********/
+
+#include "btsearchresultmodel.h"
+
+#include <cstddef>
+#include <QMimeData>
+#include <utility>
+#include "../../backend/drivers/cswordmoduleinfo.h"
+#include "../../util/btassert.h"
+#include "../BtMimeData.h"
+
+// Sword includes:
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wextra-semi"
+#pragma GCC diagnostic ignored "-Wsuggest-override"
+#pragma GCC diagnostic ignored "-Wzero-as-null-pointer-constant"
+#include <swkey.h>
+#pragma GCC diagnostic pop
+
+
+namespace Search {
+
+BtSearchResultModel::BtSearchResultModel(QObject * parent)
+    : QAbstractListModel(parent)
+{}
+
+void BtSearchResultModel::setResults(
+        CSwordModuleInfo const * module,
+        CSwordModuleSearch::ModuleResultList results)
+{
+    beginResetModel();
+    m_module = module;
+    m_results = std::move(results);
+    m_keyNames.clear();
+    endResetModel();
+}
+
+void BtSearchResultModel::setKeyNames(CSwordModuleInfo const * module,
+                                      QStringList keyNames)
+{
+    beginResetModel();
+    m_module = module;
+    m_results.clear();
+    m_keyNames = std::move(keyNames);
+    endResetModel();
+}
+
+void BtSearchResultModel::clear() {
+    beginResetModel();
+    m_module = nullptr;
+    m_results.clear();
+    m_keyNames.clear();
+    endResetModel();
+}
+
+QString BtSearchResultModel::keyName(QModelIndex const & index) const {
+    if (!index.isValid() || index.row() >= resultCount())
+        return {};
+    return keyNameAt(sourceRow(index.row()));
+}
+
+QStringList BtSearchResultModel::keyNames(QModelIndexList const & indexes)
+        const
+{
+    QStringList r;
+    r.reserve(indexes.size());
+    for (auto const & index : indexes)
+        if (index.isValid() && index.column() == 0)
+            r.append(keyName(index));
+    return r;
+}
+
+int BtSearchResultModel::rowCount(QModelIndex const & parent) const {
+    if (parent.isValid())
+        return 0;
+    return resultCount();
+}
+
+QVariant BtSearchResultModel::data(QModelIndex const & index, int role) const
+{
+    if (role != Qt::DisplayRole
+        || !index.isValid()
+        || index.column() != 0
+        || index.row() >= resultCount())
+        return {};
+    return keyNameAt(sourceRow(index.row()));
+}
+
+QVariant BtSearchResultModel::headerData(int section,
+                                         Qt::Orientation orientation,
+                                         int role) const
+{
+    if (role == Qt::DisplayRole
+        && orientation == Qt::Horizontal
+        && section == 0)
+        return tr("Results");
+    return {};
+}
+
+Qt::ItemFlags BtSearchResultModel::flags(QModelIndex const & index) const {
+    auto f = QAbstractListModel::flags(index);
+    if (index.isValid())
+        f |= Qt::ItemIsDragEnabled;
+    return f;
+}
+
+void BtSearchResultModel::sort(int column, Qt::SortOrder order) {
+    /* The hits are already in module order, hence sorting is only a matter of
+       reversing the row mapping. */
+    if (column != 0 || order == m_sortOrder)
+        return;
+
+    Q_EMIT layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+    m_sortOrder = order;
+    auto const lastRow = resultCount() - 1;
+    auto const oldIndexes(persistentIndexList());
+    QModelIndexList newIndexes;
+    newIndexes.reserve(oldIndexes.size());
+    for (auto const & oldIndex : oldIndexes)
+        newIndexes.append(index(lastRow - oldIndex.row(), oldIndex.column()));
+    changePersistentIndexList(oldIndexes, newIndexes);
+    Q_EMIT layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+}
+
+QMimeData * BtSearchResultModel::mimeData(QModelIndexList const & indexes)
+        const
+{
+    if (indexes.empty() || !m_module)
+        return nullptr;
+    BTMimeData::ItemList bookmarks;
+    for (auto const & keyName : keyNames(indexes))
+        bookmarks.append({m_module->name(), keyName, {}});
+    return new BTMimeData(std::move(bookmarks));
+}
+
+QStringList BtSearchResultModel::mimeTypes() const
+{ return QStringList(QStringLiteral("BibleTime/Bookmark")); }
+
+int BtSearchResultModel::resultCount() const noexcept {
+    return m_results.empty()
+           ? static_cast<int>(m_keyNames.size())
+           : static_cast<int>(m_results.size());
+}
+
+int BtSearchResultModel::sourceRow(int row) const noexcept {
+    return (m_sortOrder == Qt::AscendingOrder)
+           ? row
+           : resultCount() - 1 - row;
+}
+
+QString BtSearchResultModel::keyNameAt(int sourceRow) const {
+    BT_ASSERT(sourceRow >= 0 && sourceRow < resultCount());
+    if (m_results.empty())
+        return m_keyNames.at(sourceRow);
+    return QString::fromUtf8(
+                m_results[static_cast<std::size_t>(sourceRow)]->getText());
+}
+
+} // namespace Search
@@ -0,0 +1,103 @@
+/*********
+*
+* In the name of the Father, and of the Son, and of the Holy Spirit.
+*
+* This file is part of BibleTime's source code, https://bibletime.info/
+*
+* Copyright 1999-2021 by the BibleTime developers.
+* The BibleTime source code is licensed under the GNU General Public License
+* version 2.0.
+*
+**********/
+
+#pragma once
+
+#include <QAbstractListModel>
+
+#include <QModelIndex>
+#include <QModelIndexList>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <Qt>
+#include <QVariant>
+#include "../../backend/cswordmodulesearch.h"
+
+
+class CSwordModuleInfo;
+class QMimeData;
+
+namespace Search {
+
+/**
+  A flat list model over the hits of a single module. Unlike the former item
+  based view it does not copy the key names of the hits, but asks the
+  underlying keys for their text only when a row is actually requested, i.e.
+  when it becomes visible. Sorting is done by remapping rows, so neither setting
+  the results nor sorting them depends on the number of hits.
+*/
+class BtSearchResultModel: public QAbstractListModel {
+
+    Q_OBJECT
+
+public: // methods:
+
+    BtSearchResultModel(QObject * parent = nullptr);
+
+    /**
+      \brief Sets the hits of the given module as the contents of this model.
+      \param[in] module The module searched.
+      \param[in] results The hits in module order.
+    */
+    void setResults(CSwordModuleInfo const * module,
+                    CSwordModuleSearch::ModuleResultList results);
+
+    /**
+      \brief Sets the given key names as the contents of this model.
+      \param[in] module The module the keys refer to.
+      \param[in] keyNames The key names in module order.
+    */
+    void setKeyNames(CSwordModuleInfo const * module, QStringList keyNames);
+
+    /** \brief Removes all hits from this model. */
+    void clear();
+
+    /** \returns the module of the current hits. */
+    CSwordModuleInfo const * module() const noexcept { return m_module; }
+
+    /** \returns the key name of the hit at the given index. */
+    QString keyName(QModelIndex const & index) const;
+
+    /** \returns the key names of the hits at the given indexes. */
+    QStringList keyNames(QModelIndexList const & indexes) const;
+
+    // Virtual methods implemented from QAbstractListModel:
+    int rowCount(QModelIndex const & parent = QModelIndex()) const override;
+    QVariant data(QModelIndex const & index, int role) const override;
+    QVariant headerData(int section,
+                        Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(QModelIndex const & index) const override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+    QMimeData * mimeData(QModelIndexList const & indexes) const override;
+    QStringList mimeTypes() const override;
+
+private: // methods:
+
+    int resultCount() const noexcept;
+
+    /** \returns the position in module order of the given row. */
+    int sourceRow(int row) const noexcept;
+
+    QString keyNameAt(int sourceRow) const;
+
+private: // fields:
+
+    CSwordModuleInfo const * m_module = nullptr;
+    CSwordModuleSearch::ModuleResultList m_results;
+    QStringList m_keyNames;
+    Qt::SortOrder m_sortOrder = Qt::AscendingOrder;
+
+};
+
+} // namespace Search
@@ -14,22 +14,18 @@
 
 #include <QAction>
 #include <QContextMenuEvent>
+#include <QHeaderView>
+#include <QItemSelectionModel>
 #include <QMenu>
 #include <QStringList>
-#include <QtAlgorithms>
-#include <QTreeWidget>
-#include <QTreeWidgetItem>
-#include <vector>
 #include "../../backend/config/btconfig.h"
 #include "../../backend/cswordmodulesearch.h"
 #include "../../backend/drivers/cswordmoduleinfo.h"
-#include "../../backend/managers/cswordbackend.h"
-#include "../../util/btassert.h"
 #include "../../util/btconnect.h"
 #include "../../util/cresmgr.h"
 #include "../../util/tool.h"
 #include "../cexportmanager.h"
-#include "btsearchresultarea.h"
+#include "btmoduleresultmodel.h"
 
 
 namespace Search {
@@ -39,30 +35,29 @@ namespace Search {
 ********************************************/
 
 CModuleResultView::CModuleResultView(QWidget* parent)
-        : QTreeWidget(parent) {
+        : QTreeView(parent)
+        , m_model(new BtModuleResultModel(this)) {
     initView();
     initConnections();
 }
 
-CModuleResultView::~CModuleResultView() {
-    qDeleteAll(m_strongsResults);
-}
-
 
 /** Initializes this widget. */
 void CModuleResultView::initView() {
     // see also csearchresultview.cpp
     setToolTip(tr("Works chosen for the search and the number of the hits in each work"));
-    setHeaderLabels( QStringList(tr("Work")) << tr("Hits") );
+    setModel(m_model);
+    setUniformRowHeights(true);
 
     setColumnWidth(0, util::tool::mWidth(this, 8));
     setColumnWidth(1, util::tool::mWidth(this, 4));
     QSize sz(util::tool::mWidth(this, 13), util::tool::mWidth(this, 5));
     //setMinimumSize(sz);
     m_size = sz;
-    /// \todo sorting
-    //setSorting(0, true);
-    //setSorting(1, true);
+
+    // Keep the order of the search until the user sorts by a column:
+    header()->setSortIndicator(-1, Qt::AscendingOrder);
+    setSortingEnabled(true);
 
     //setup the popup menu
     m_popup = new QMenu(this);
@@ -74,7 +69,7 @@ void CModuleResultView::initView() {
                [this]{
                    if (auto * const m = activeModule())
                        CExportManager(true, tr("Copying search result"))
-                               .copyKeyList(m_results[m],
+                               .copyKeyList(m_model->results(currentIndex()),
                                             m,
                                             CExportManager::Text,
                                             false);
@@ -85,7 +80,7 @@ void CModuleResultView::initView() {
                [this]{
                    if (auto * const m = activeModule())
                        CExportManager(true, tr("Copying search result"))
-                               .copyKeyList(m_results[m],
+                               .copyKeyList(m_model->results(currentIndex()),
                                             m,
                                             CExportManager::Text,
                                             true);
@@ -100,7 +95,7 @@ void CModuleResultView::initView() {
                [this]{
                    if (auto * const m = activeModule())
                        CExportManager(true, tr("Saving search result"))
-                               .saveKeyList(m_results[m],
+                               .saveKeyList(m_model->results(currentIndex()),
                                             m,
                                             CExportManager::Text,
                                             false);
@@ -111,7 +106,7 @@ void CModuleResultView::initView() {
                [this]{
                    if (auto * const m = activeModule())
                        CExportManager(true, tr("Saving search result"))
-                               .saveKeyList(m_results[m],
+                               .saveKeyList(m_model->results(currentIndex()),
                                             m,
                                             CExportManager::Text,
                                             true);
@@ -126,7 +121,7 @@ void CModuleResultView::initView() {
                [this]{
                    if (auto * const m = activeModule())
                        CExportManager(true, tr("Printing search result"))
-                               .printKeyList(m_results[m],
+                               .printKeyList(m_model->results(currentIndex()),
                                              m,
                                              btConfig().getDisplayOptions(),
                                              btConfig().getFilterOptions());
@@ -137,125 +132,66 @@ void CModuleResultView::initView() {
 
 /** Initializes the connections of this widget, */
 void CModuleResultView::initConnections() {
-    /// \todo
-    BT_CONNECT(this, &CModuleResultView::currentItemChanged,
+    BT_CONNECT(selectionModel(), &QItemSelectionModel::currentChanged,
                this, &CModuleResultView::executed);
 }
 
 void CModuleResultView::setupTree(const CSwordModuleSearch::Results & results,
                                   const QString & searchedText)
 {
-    /// \todo implement sorting in this method.
-
-    clear();
-    m_results.clear();
-    qDeleteAll(m_strongsResults);
-    m_strongsResults.clear();
-
-    bool strongsAvailable = false;
-
-    for (auto const & result : results) {
-        auto const * const m = result.module;
-        BT_ASSERT(!m_results.contains(m));
-        m_results.insert(m, result.results);
-        QTreeWidgetItem * const item =
-                new QTreeWidgetItem(this,
-                                    QStringList(m->name())
-                                    << QString::number(result.results.size()));
-
-        item->setIcon(0, util::tool::getIconForModule(m));
+    /*
+      We need to make a decision here.  Either don't show any Strong's
+      number translations, or show the first one in the search text, or
+      figure out how to show them all. I choose option number 2 at this time.
+    */
+    QString sNumber;
+
+    // strong search text index for finding "strong:"
+    int sstIndex = searchedText.indexOf(QStringLiteral("strong:"), 0);
+    if (sstIndex != -1) {
         /*
-          We need to make a decision here.  Either don't show any Strong's
-          number translations, or show the first one in the search text, or
-          figure out how to show them all. I choose option number 2 at this time.
+          Get the strongs number from the search text. First find the first
+          space after "strong:". This should indicate a change in search
+          token
         */
-
-        // strong search text index for finding "strong:"
-        int sstIndex = searchedText.indexOf(QStringLiteral("strong:"), 0);
-        if (sstIndex != -1) {
-            /*
-              Get the strongs number from the search text. First find the first
-              space after "strong:". This should indicate a change in search
-              token
-            */
-            sstIndex += 7;
-            const int sTokenIndex = searchedText.indexOf(' ', sstIndex);
-            const QString sNumber(searchedText.mid(sstIndex, sTokenIndex - sstIndex));
-
-            setupStrongsResults(m, result.results, item, sNumber);
-
-            /// \todo item->setOpen(true);
-            strongsAvailable = true;
-        }
+        sstIndex += 7;
+        const int sTokenIndex = searchedText.indexOf(' ', sstIndex);
+        sNumber = searchedText.mid(sstIndex, sTokenIndex - sstIndex);
     }
 
+    /* The Strong's translations of a module are only parsed by the model when
+       the module is expanded: */
+    m_model->setResults(results, sNumber);
+
     // Allow to hide the module strongs if there are any available
-    setRootIsDecorated( strongsAvailable );
+    setRootIsDecorated(!sNumber.isEmpty());
 }
 
-void CModuleResultView::setupStrongsResults(
-        CSwordModuleInfo const * module,
-        CSwordModuleSearch::ModuleResultList const & results,
-        QTreeWidgetItem * parent,
-        QString const & sNumber)
-{
-    StrongsResultList *m = new StrongsResultList(module, results, sNumber);
-    m_strongsResults[module] = m;
+void CModuleResultView::clear() { m_model->clear(); }
 
-    for (int cnt = 0; cnt < m->count(); ++cnt) {
-        QStringList columns(m->at(cnt).keyText());
-        columns.append(QString::number(m->at(cnt).keyCount()));
-        new QTreeWidgetItem(parent, columns);
-    }
-}
+void CModuleResultView::selectFirstModule()
+{ setCurrentIndex(m_model->index(0, 0)); }
 
-/// \todo
 /** Is executed when an item was selected in the list. */
-void CModuleResultView::executed( QTreeWidgetItem* i, QTreeWidgetItem*) {
-    QString itemText;
-
-    if (!i) {
+void CModuleResultView::executed(QModelIndex const & current) {
+    if (!current.isValid()) {
         //Clear list
         Q_EMIT moduleChanged();
         return;
     }
-    if (auto * const m = CSwordBackend::instance().findModuleByName(i->text(0)))
-    {
-        Q_EMIT moduleChanged();
-        Q_EMIT moduleSelected(m, m_results.value(m));
-        return;
-    }
-
-    StrongsResultList *strongsResult = m_strongsResults[activeModule()];
-
-    if (!strongsResult) {
-        return;
-    }
 
-    itemText = i->text(0);
-    for (int cnt = 0; cnt < strongsResult->count(); cnt++) {
-        if (strongsResult->at(cnt).keyText() == itemText) {
-            //clear the verses list
-            Q_EMIT moduleChanged();
-            Q_EMIT strongsSelected(activeModule(),
-                                 strongsResult->at(cnt).getKeyList());
-            return;
-        }
+    auto const * const m = m_model->module(current);
+    Q_EMIT moduleChanged();
+    if (m_model->isStrongsIndex(current)) {
+        Q_EMIT strongsSelected(m, m_model->strongsKeyNames(current));
+    } else {
+        Q_EMIT moduleSelected(m, m_model->results(current));
     }
 }
 
 /** Returns the currently active module. */
-CSwordModuleInfo* CModuleResultView::activeModule() {
-    QTreeWidgetItem * item = currentItem();
-    BT_ASSERT(item);
-
-    // we need to find the parent most node because that is the node
-    // that is the module name.
-    while (item->parent())
-        item = item->parent();
-
-    return CSwordBackend::instance().findModuleByName(item->text(0));
-}
+CSwordModuleInfo const * CModuleResultView::activeModule() const
+{ return m_model->module(currentIndex()); }
 
 /** Reimplementation from QWidget. */
 void CModuleResultView::contextMenuEvent( QContextMenuEvent * event ) {
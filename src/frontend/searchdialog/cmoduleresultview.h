@@ -12,9 +12,9 @@
 
 #pragma once
 
-#include <QTreeWidget>
+#include <QTreeView>
 
-#include <QHash>
+#include <QModelIndex>
 #include <QObject>
 #include <QSize>
 #include <QString>
@@ -30,13 +30,12 @@ class QWidget;
 
 namespace Search {
 
-class StrongsResultList;
+class BtModuleResultModel;
 
-class CModuleResultView : public QTreeWidget {
+class CModuleResultView : public QTreeView {
         Q_OBJECT
     public:
         CModuleResultView(QWidget* parent);
-        ~CModuleResultView() override;
 
         /**
           Setups the tree using the given list of modules.
@@ -44,10 +43,16 @@ class CModuleResultView : public QTreeWidget {
         void setupTree(const CSwordModuleSearch::Results &results,
                        const QString &searchedText);
 
+        /** \brief Removes all results from this view. */
+        void clear();
+
+        /** \brief Makes the first module of the results the current one. */
+        void selectFirstModule();
+
         /**
         * Returns the currently active module.
         */
-        CSwordModuleInfo* activeModule();
+        CSwordModuleInfo const * activeModule() const;
 
         QSize sizeHint() const override {
             return m_size;
@@ -63,17 +68,11 @@ class CModuleResultView : public QTreeWidget {
         */
         void initConnections();
 
-
-        void setupStrongsResults(const CSwordModuleInfo *module,
-                                 CSwordModuleSearch::ModuleResultList const & results,
-                                 QTreeWidgetItem *parent,
-                                 const QString &searchedText);
-
     protected Q_SLOTS:
         /**
         * Is executed when an item was selected in the list.
         */
-        void executed(QTreeWidgetItem*, QTreeWidgetItem*);
+        void executed(QModelIndex const & current);
         /**
         * This event handler (reimplemented from QWidget) opens the popup menu at the given position.
         */
@@ -83,7 +82,7 @@ class CModuleResultView : public QTreeWidget {
         void moduleSelected(CSwordModuleInfo const *,
                             CSwordModuleSearch::ModuleResultList const &);
         void moduleChanged();
-        void strongsSelected(CSwordModuleInfo*, const QStringList&);
+        void strongsSelected(CSwordModuleInfo const *, QStringList const &);
 
     private:
         struct {
@@ -111,9 +110,7 @@ class CModuleResultView : public QTreeWidget {
 
         QMenu* m_popup;
 
-        QHash<CSwordModuleInfo const *, CSwordModuleSearch::ModuleResultList>
-                m_results;
-        QHash<const CSwordModuleInfo*, StrongsResultList*> m_strongsResults;
+        BtModuleResultModel * const m_model;
         QSize m_size;
 };
 
@@ -13,36 +13,50 @@
 #include "csearchresultview.h"
 
 #include <QContextMenuEvent>
+#include <QHeaderView>
+#include <QItemSelectionModel>
 #include <QList>
 #include <QMenu>
-#include <QTreeWidget>
-#include <QTreeWidgetItem>
+#include <QModelIndex>
 #include <QWidget>
 #include "../../backend/config/btconfig.h"
 #include "../../backend/drivers/cswordmoduleinfo.h"
 #include "../../backend/keys/cswordkey.h"
 #include "../../util/btconnect.h"
 #include "../../util/cresmgr.h"
-#include "../BtMimeData.h"
 #include "../cexportmanager.h"
+#include "btsearchresultmodel.h"
 
 
 namespace Search {
 
 CSearchResultView::CSearchResultView(QWidget* parent)
-        : QTreeWidget(parent),
-        m_module(nullptr) {
+        : QTreeView(parent),
+        m_model(new BtSearchResultModel(this)) {
     initView();
     initConnections();
 }
 
+CSwordModuleInfo const * CSearchResultView::module() const
+{ return m_model->module(); }
+
+void CSearchResultView::clear() { m_model->clear(); }
+
+QStringList CSearchResultView::selectedKeyNames() const
+{ return m_model->keyNames(selectionModel()->selectedRows()); }
+
 /** Initializes the view of this widget. */
 void CSearchResultView::initView() {
     setToolTip(tr("Search result of the selected work"));
-    setHeaderLabel(tr("Results"));
+    setModel(m_model);
+    /* Uniform row heights allow the view to only query the visible rows, so
+       the key texts of the hits are only generated when they are shown. */
+    setUniformRowHeights(true);
     setDragEnabled(true);
     setRootIsDecorated( false );
     setSelectionMode(QAbstractItemView::ExtendedSelection);
+    setSortingEnabled(true);
+    sortByColumn(0, Qt::AscendingOrder);
 
     //setup the popup menu
     m_popup = new QMenu(this);
@@ -52,13 +66,13 @@ void CSearchResultView::initView() {
 
     struct SelectedKeysList : QList<CSwordKey *> {
         SelectedKeysList(CSearchResultView & self) {
-            auto const * const m = self.m_module;
-            auto const selectedItems(self.selectedItems());
-            reserve(selectedItems.size());
+            auto const * const m = self.module();
+            auto const keyNames(self.selectedKeyNames());
+            reserve(keyNames.size());
             try {
-                for (auto const * const i : self.selectedItems()) {
+                for (auto const & keyName : keyNames) {
                     append(m->createKey());
-                    last()->setKey(i->text(0));
+                    last()->setKey(keyName);
                 }
             } catch (...) {
                 qDeleteAll(*this);
@@ -116,12 +130,9 @@ void CSearchResultView::initView() {
     m_actions.print.result = new QAction(tr("Reference with text"), this);
     BT_CONNECT(m_actions.print.result, &QAction::triggered,
                [this]{
-                   QStringList list;
-                   for (auto const * const k : selectedItems())
-                       list.append(k->text(0));
                    CExportManager(true, tr("Printing search result"))
-                           .printKeyList(list,
-                                         m_module,
+                           .printKeyList(selectedKeyNames(),
+                                         module(),
                                          btConfig().getDisplayOptions(),
                                          btConfig().getFilterOptions());
                });
@@ -131,12 +142,10 @@ void CSearchResultView::initView() {
 
 /** No descriptions */
 void CSearchResultView::initConnections() {
-    /// \todo are these right after porting?
-    //items: current, previous
-    BT_CONNECT(this, &CSearchResultView::currentItemChanged,
-               [this](QTreeWidgetItem * const current, QTreeWidgetItem *) {
-                   if (current) {
-                       Q_EMIT keySelected(current->text(0));
+    BT_CONNECT(selectionModel(), &QItemSelectionModel::currentChanged,
+               [this](QModelIndex const & current, QModelIndex const &) {
+                   if (current.isValid()) {
+                       Q_EMIT keySelected(m_model->keyName(current));
                    } else {
                        Q_EMIT keyDeselected();
                    }
@@ -148,49 +157,28 @@ void CSearchResultView::setupTree(
         CSwordModuleInfo const * m,
         CSwordModuleSearch::ModuleResultList const & result)
 {
-    clear();
-
-    if (!m) return;
+    if (!m) {
+        clear();
+        return;
+    }
 
-    m_module = m;
+    m_model->setResults(m, result);
     if (result.empty())
         return;
 
-    setUpdatesEnabled(false);
-
-    QTreeWidgetItem* oldItem = nullptr;
-    QTreeWidgetItem* item = nullptr;
-    for (auto const & keyPtr : result) {
-        item = new QTreeWidgetItem(this, oldItem);
-        item->setText(0, QString::fromUtf8(keyPtr->getText()));
-        oldItem = item;
-    }
-
-    setUpdatesEnabled(true);
     //pre-select the first item
-    this->setCurrentItem(this->topLevelItem(0), 0);
+    setCurrentIndex(m_model->index(0));
 }
 
-void CSearchResultView::setupStrongsTree(CSwordModuleInfo* m, const QStringList &vList) {
-    clear();
-    if (!m) return;
-
-    m_module = m;
-
-    if (vList.empty()) return;
-
-    setUpdatesEnabled(false);
-
-    QTreeWidgetItem* oldItem = nullptr;
-    QTreeWidgetItem* item = nullptr;
-
-    for (auto const & s : vList) {
-        item = new QTreeWidgetItem(this, oldItem);
-        item->setText(0, (s));
-        oldItem = item;
+void CSearchResultView::setupStrongsTree(CSwordModuleInfo const * m,
+                                         QStringList const & vList)
+{
+    if (!m) {
+        clear();
+        return;
     }
 
-    setUpdatesEnabled(true);
+    m_model->setKeyNames(m, vList);
 
     /// \todo select the first item
     //setSelected(firstChild(), true);
@@ -221,17 +209,5 @@ void CSearchResultView::contextMenuEvent(QContextMenuEvent* event) {
 // }
 
 
-QMimeData * CSearchResultView::mimeData ( const QList<QTreeWidgetItem *> items ) const {
-    if (items.empty())
-        return nullptr;
-    BTMimeData::ItemList bookmarks;
-    for (auto const * const i : items)
-        bookmarks.append({m_module->name(), i->text(0), {}});
-    return new BTMimeData(std::move(bookmarks));
-}
-
-QStringList CSearchResultView::mimeTypes() const
-{ return QStringList(QStringLiteral("BibleTime/Bookmark")); }
-
 } //end of namespace
 
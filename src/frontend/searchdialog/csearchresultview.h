@@ -12,8 +12,9 @@
 
 #pragma once
 
-#include <QTreeWidget>
+#include <QTreeView>
 
+#include <QStringList>
 #include "../../backend/cswordmodulesearch.h"
 
 
@@ -24,7 +25,9 @@ class QMenu;
 
 namespace Search {
 
-class CSearchResultView  : public QTreeWidget {
+class BtSearchResultModel;
+
+class CSearchResultView  : public QTreeView {
         Q_OBJECT
     public:
         CSearchResultView(QWidget* parent);
@@ -32,7 +35,10 @@ class CSearchResultView  : public QTreeWidget {
         /**
           \returns the module which is currently used.
         */
-        CSwordModuleInfo const * module() const { return m_module; }
+        CSwordModuleInfo const * module() const;
+
+        /** \brief Removes all hits from this view. */
+        void clear();
 
     protected: // methods:
         /**
@@ -41,9 +47,8 @@ class CSearchResultView  : public QTreeWidget {
         void initView();
         void initConnections();
 
-        //from QTreeWidget
-        QMimeData * mimeData ( const QList<QTreeWidgetItem *> items ) const override;
-        QStringList mimeTypes () const override;
+        /** \returns the key names of the selected hits. */
+        QStringList selectedKeyNames() const;
 
     public Q_SLOTS:
 
@@ -53,7 +58,7 @@ class CSearchResultView  : public QTreeWidget {
         void setupTree(CSwordModuleInfo const * m,
                        CSwordModuleSearch::ModuleResultList const & results);
 
-        void setupStrongsTree(CSwordModuleInfo*, const QStringList&);
+        void setupStrongsTree(CSwordModuleInfo const *, QStringList const &);
 
         void contextMenuEvent(QContextMenuEvent* event) override;
 
@@ -82,7 +87,7 @@ class CSearchResultView  : public QTreeWidget {
         m_actions;
 
         QMenu* m_popup;
-        const CSwordModuleInfo *m_module;
+        BtSearchResultModel * const m_model;
 
     Q_SIGNALS:
         void keySelected(const QString&);